@@ -0,0 +1,162 @@
+
+
+#include "MicroBenchmark.hpp"
+
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+
+const double MicroBenchmark::SAMPLE_NANOSECONDS = 2000.0;
+
+
+static std::string json_text(const std::string& line, const std::string& key)
+{
+	std::string start = "\"" + key + "\": \"";
+	std::size_t position = line.find(start);
+	if(position == std::string::npos)
+	{
+		return "";
+	}
+	position += start.size();
+	return line.substr(position, line.find('"', position) - position);
+}
+
+
+static double json_number(const std::string& line, const std::string& key)
+{
+	std::string start = "\"" + key + "\": ";
+	std::size_t position = line.find(start);
+	return position == std::string::npos ? NAN : std::strtod(line.c_str() + position + start.size(), nullptr);
+}
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+MicroBenchmark::MicroBenchmark(std::size_t samples, const std::string& filter/*=""*/)
+/*
+Only benchmarks whose names contain `filter` are run.
+*/
+: _samples{std::max<std::size_t>(samples, 100)}, _filter{filter}, _sink{0.0}
+{}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+std::vector<MicroBenchmark::Result> MicroBenchmark::read(const std::string& path)
+/*
+The results in a file from `write()`.
+*/
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("Unable to open benchmark results " + path);
+	}
+
+	std::vector<Result> results;
+	std::string line;
+	while(std::getline(file, line))
+	{
+		std::string name = json_text(line, "name");
+		if(!name.empty())
+		{
+			results.push_back(Result{name, static_cast<std::size_t>(json_number(line, "calls")),
+				static_cast<std::size_t>(json_number(line, "samples")), json_number(line, "p50_ns"),
+				json_number(line, "p99_ns"), json_number(line, "per_second")});
+		}
+	}
+	return results;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+const std::vector<MicroBenchmark::Result>& MicroBenchmark::results() const
+{
+	return _results;
+}
+
+
+double MicroBenchmark::sink() const
+{
+	return _sink;
+}
+
+
+void MicroBenchmark::write(const std::string& path) const
+{
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if(!file)
+	{
+		throw std::runtime_error("Unable to write benchmark results " + path);
+	}
+
+	std::fprintf(file, "{\n\t\"benchmarks\": [\n");
+	for(std::size_t index = 0; index < _results.size(); index++)
+	{
+		const Result& result = _results[index];
+		std::fprintf(file, "\t\t{\"name\": \"%s\", \"calls\": %zu, \"samples\": %zu, \"p50_ns\": %.3f, "
+			"\"p99_ns\": %.3f, \"per_second\": %.1f}%s\n", result.name.c_str(), result.calls, result.samples,
+			result.p50_nanoseconds, result.p99_nanoseconds, result.per_second, index + 1 < _results.size() ? "," : "");
+	}
+	std::fprintf(file, "\t]\n}\n");
+	std::fclose(file);
+}
+
+
+std::string MicroBenchmark::report(const std::vector<Result>& baseline) const
+/*
+A table of the results; with a `baseline`, each p50 also as a change from the baseline's result of the same name
+ (positive is slower).
+*/
+{
+	std::string text;
+	char line[256];
+	std::snprintf(line, sizeof(line), "%-44s %12s %12s %14s%s\n", "benchmark", "p50 [ns]", "p99 [ns]", "per second",
+		baseline.empty() ? "" : "   p50 vs baseline");
+	text += line;
+	for(const Result& result : _results)
+	{
+		std::snprintf(line, sizeof(line), "%-44s %12.1f %12.1f %14.4g", result.name.c_str(), result.p50_nanoseconds,
+			result.p99_nanoseconds, result.per_second);
+		text += line;
+		for(const Result& previous : baseline)
+		{
+			if(previous.name == result.name && previous.p50_nanoseconds > 0.0)
+			{
+				double change = result.p50_nanoseconds / previous.p50_nanoseconds - 1.0;
+				std::snprintf(line, sizeof(line), "   %+7.1f%%", 100.0 * change);
+				text += line;
+			}
+		}
+		text += "\n";
+	}
+	return text;
+}
+
+
+bool MicroBenchmark::selected(const std::string& name) const
+{
+	return name.find(_filter) != std::string::npos;
+}
+
+
+void MicroBenchmark::add(const std::string& name, std::size_t calls, std::vector<double>& nanoseconds,
+	double per_second
+)
+/*
+Nearest rank percentiles of `nanoseconds` (which are reordered).
+*/
+{
+	std::size_t median = (nanoseconds.size() + 1) / 2 - 1;
+	std::nth_element(nanoseconds.begin(), nanoseconds.begin() + median, nanoseconds.end());
+	double p50 = nanoseconds[median];
+	std::size_t tail = static_cast<std::size_t>(std::ceil(nanoseconds.size() * 0.99)) - 1;
+	std::nth_element(nanoseconds.begin(), nanoseconds.begin() + tail, nanoseconds.end());
+	double p99 = nanoseconds[tail];
+	_results.push_back(Result{name, calls, nanoseconds.size(), p50, p99, per_second});
+}
@@ -0,0 +1,125 @@
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+class MicroBenchmark
+/*
+Times the stages of the tide for `make bench`. `latency()` benchmarks a single call: each sample times enough
+ consecutive calls (`calls`, at least `SAMPLE_NANOSECONDS` worth, so that the clock's own cost does not count) and
+ divides, so p50 & p99 are of the per-call time over `samples` samples. `throughput()` benchmarks a whole batch of
+ `evaluations`, one batch per sample, and reports evaluations per second at the median.
+Calls get an index to choose their inputs from (so that nothing is constant folded) & return a value that is summed
+ into `sink()`. Results are written as JSON, one benchmark per line, & compared against a previous such file.
+*/
+{
+	public:
+		static const double SAMPLE_NANOSECONDS;  // 2 µs
+
+		struct Result
+		{
+			std::string name;
+			std::size_t calls;  // Calls per sample; 1 for batches
+			std::size_t samples;
+			double p50_nanoseconds;  // Per call, or per batch
+			double p99_nanoseconds;
+			double per_second;  // Calls, or evaluations
+		};
+
+		MicroBenchmark(std::size_t samples, const std::string& filter="");
+
+		template<class Call>
+		void latency(const std::string& name, Call call);
+		template<class Batch>
+		void throughput(const std::string& name, std::size_t evaluations, Batch batch);
+
+		const std::vector<Result>& results() const;
+		double sink() const;
+
+		void write(const std::string& path) const;
+		static std::vector<Result> read(const std::string& path);
+		std::string report(const std::vector<Result>& baseline) const;
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		bool selected(const std::string& name) const;
+		void add(const std::string& name, std::size_t calls, std::vector<double>& nanoseconds, double per_second);
+
+		const std::size_t _samples;
+		const std::string _filter;
+		std::vector<Result> _results;
+		volatile double _sink;
+};
+
+
+template<class Call>
+void MicroBenchmark::latency(const std::string& name, Call call)
+{
+	if(!selected(name))
+	{
+		return;
+	}
+
+	double sink = 0.0;
+	std::size_t index = 0;
+	std::size_t calls = 1;
+	while(true)
+	{
+		Clock::time_point start = Clock::now();
+		for(std::size_t repeat = 0; repeat < calls; repeat++)
+		{
+			sink += call(index++);
+		}
+		if(std::chrono::duration<double, std::nano>(Clock::now() - start).count() >= SAMPLE_NANOSECONDS)
+		{
+			break;
+		}
+		calls *= 2;
+	}
+
+	std::vector<double> nanoseconds(_samples);
+	double total = 0.0;
+	for(std::size_t sample = 0; sample < _samples; sample++)
+	{
+		Clock::time_point start = Clock::now();
+		for(std::size_t repeat = 0; repeat < calls; repeat++)
+		{
+			sink += call(index++);
+		}
+		nanoseconds[sample] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+		total += nanoseconds[sample];
+	}
+	_sink = _sink + sink;
+	add(name, calls, nanoseconds, 1e9 * _samples / total);
+}
+
+
+template<class Batch>
+void MicroBenchmark::throughput(const std::string& name, std::size_t evaluations, Batch batch)
+{
+	if(!selected(name))
+	{
+		return;
+	}
+
+	double sink = batch();  // Warm up
+	std::size_t samples = std::max<std::size_t>(_samples / 200, 5);
+	std::vector<double> nanoseconds(samples);
+	for(std::size_t sample = 0; sample < samples; sample++)
+	{
+		Clock::time_point start = Clock::now();
+		sink += batch();
+		nanoseconds[sample] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}
+	_sink = _sink + sink;
+	add(name, 1, nanoseconds, 0.0);
+	_results.back().per_second = 1e9 * evaluations / _results.back().p50_nanoseconds;
+}
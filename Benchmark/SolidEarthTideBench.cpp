@@ -0,0 +1,306 @@
+
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+#include "ChebyshevEphemeris.hpp"
+#include "Coordinate.hpp"
+#include "EphemerisKernels.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JobPlanner.hpp"
+#include "JulianDate.hpp"
+#include "MicroBenchmark.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+
+
+static const char USAGE[] =
+	"Usage: SolidEarthTideBench [--output FILE.json] [--baseline FILE.json] [--filter TEXT] [--samples N]\n";
+
+static const std::size_t INPUTS = 64;  // Epochs & stations the single call benchmarks cycle through (a power of 2)
+static const std::size_t KERNEL_BLOCK = 256;  // Epochs per `EphemerisKernels` call, as `Geolocation::SERIES_BLOCK`
+
+
+int main(int argument_count, char* arguments[])
+/*
+`make bench`: every stage of the tide, from `Coordinate` operations to whole series, on `INPUTS` epochs through 2020 &
+ stations over the globe.
+*/
+{
+	std::string output, baseline_path, filter;
+	std::size_t samples = 2000;
+	for(int index = 1; index < argument_count; index += 2)
+	{
+		std::string flag = arguments[index];
+		if(index + 1 == argument_count
+		  || (flag != "--output" && flag != "--baseline" && flag != "--filter" && flag != "--samples")
+		)
+		{
+			std::cerr << USAGE;
+			return 1;
+		}
+		std::string value = arguments[index + 1];
+		if(flag == "--output")
+		{
+			output = value;
+		}
+		else if(flag == "--baseline")
+		{
+			baseline_path = value;
+		}
+		else if(flag == "--filter")
+		{
+			filter = value;
+		}
+		else
+		{
+			samples = std::strtoul(value.c_str(), nullptr, 10);
+		}
+	}
+
+	const unsigned int modified_julian_date = 58849;  // 2020-01-01
+	std::vector<JulianDate> julian_dates;
+	std::vector<EpochContext> epoch_contexts;
+	std::vector<Geolocation> geolocations;
+	std::vector<StationFrame> station_frames;
+	std::vector<Coordinate<double>> solar_coordinates, lunar_coordinates, coordinates;
+	std::vector<double> solar_factors, lunar_factors, terrestrial_times;
+	geolocations.reserve(INPUTS);
+	for(std::size_t index = 0; index < INPUTS; index++)
+	{
+		double fraction = index * 0.618034 - std::floor(index * 0.618034);
+		julian_dates.push_back(JulianDate(modified_julian_date + 5 * index, fraction));
+		epoch_contexts.push_back(EpochContext(modified_julian_date, julian_dates.back()));
+		geolocations.push_back(Geolocation(-80.0 + 160.0 * index / INPUTS, 360.0 * ((index * 7) % INPUTS) / INPUTS,
+			100.0 * (index % 5)));
+		station_frames.push_back(StationFrame(geolocations.back()));
+		solar_coordinates.push_back(Geolocation::sun_coordinates(epoch_contexts.back()));
+		lunar_coordinates.push_back(Geolocation::moon_coordinates(epoch_contexts.back(),
+			Geolocation::LunarSeries::ANGLE_ADDITION));
+		coordinates.push_back(Coordinate<double>(geolocations.back()));
+		solar_factors.push_back(Geolocation::SOLAR_MASS_RATIO * Geolocation::RE
+			* std::pow(Geolocation::RE / solar_coordinates.back().distance(), 3));
+		lunar_factors.push_back(Geolocation::LUNAR_MASS_RATIO * Geolocation::RE
+			* std::pow(Geolocation::RE / lunar_coordinates.back().distance(), 3));
+		terrestrial_times.push_back(epoch_contexts.back().julian_centuries);
+	}
+	const std::size_t MASK = INPUTS - 1;
+
+	MicroBenchmark benchmark(samples, filter);
+
+	// Coordinate
+	benchmark.latency("coordinate/distance", [&](std::size_t index){ return coordinates[index & MASK].distance(); });
+	benchmark.latency("coordinate/dot",
+		[&](std::size_t index){ return coordinates[index & MASK] * solar_coordinates[index & MASK]; });
+	benchmark.latency("coordinate/rotate3",
+		[&](std::size_t index){ return coordinates[index & MASK].rotate3(index * 1e-3)[X]; });
+	benchmark.latency("coordinate/rotate3_sin_cos",
+		[&](std::size_t index)
+		{
+			const EpochContext& epoch_context = epoch_contexts[index & MASK];
+			return coordinates[index & MASK].rotate3(epoch_context.sin_greenwich_hour_angle,
+				epoch_context.cos_greenwich_hour_angle)[X];
+		}
+	);
+	benchmark.latency("coordinate/geodetic_cartesian_system",
+		[&](std::size_t index){ return coordinates[index & MASK].geodetic_cartesian_system(0.7, index * 1e-3)[Z]; });
+
+	// Time
+	benchmark.latency("julian_date/UTC_to_TAI",
+		[&](std::size_t index){ return julian_dates[index & MASK].UTC_to_TAI(modified_julian_date); });
+	benchmark.latency("julian_date/GreenwichHourAngleRadians",
+		[&](std::size_t index){ return julian_dates[index & MASK].GreenwichHourAngleRadians(); });
+	benchmark.latency("epoch_context",
+		[&](std::size_t index)
+		{
+			return EpochContext(modified_julian_date, julian_dates[index & MASK]).greenwich_hour_angle;
+		}
+	);
+
+	// Ephemerides
+	benchmark.latency("sun_coordinates/julian_date",
+		[&](std::size_t index)
+		{
+			return Geolocation::sun_coordinates(modified_julian_date, julian_dates[index & MASK])[X];
+		}
+	);
+	benchmark.latency("sun_coordinates/epoch_context",
+		[&](std::size_t index){ return Geolocation::sun_coordinates(epoch_contexts[index & MASK])[X]; });
+	benchmark.latency("moon_coordinates/julian_date",
+		[&](std::size_t index)
+		{
+			return Geolocation::moon_coordinates(modified_julian_date, julian_dates[index & MASK])[X];
+		}
+	);
+	benchmark.latency("moon_coordinates/epoch_context/direct",
+		[&](std::size_t index)
+		{
+			return Geolocation::moon_coordinates(epoch_contexts[index & MASK], Geolocation::LunarSeries::DIRECT)[X];
+		}
+	);
+	benchmark.latency("moon_coordinates/epoch_context/angle_addition",
+		[&](std::size_t index)
+		{
+			return Geolocation::moon_coordinates(epoch_contexts[index & MASK],
+				Geolocation::LunarSeries::ANGLE_ADDITION)[X];
+		}
+	);
+	double kernel_x[KERNEL_BLOCK], kernel_y[KERNEL_BLOCK], kernel_z[KERNEL_BLOCK];
+	std::vector<double> kernel_times(KERNEL_BLOCK);
+	for(std::size_t index = 0; index < KERNEL_BLOCK; index++)
+	{
+		kernel_times[index] = terrestrial_times[index & MASK] + index * 1e-7;
+	}
+	benchmark.throughput(std::string("ephemeris_kernels/sun/") + EphemerisKernels::instruction_set(), KERNEL_BLOCK,
+		[&]()
+		{
+			EphemerisKernels::sun_inertial_coordinates(kernel_times.data(), KERNEL_BLOCK, kernel_x, kernel_y,
+				kernel_z);
+			return kernel_x[0];
+		}
+	);
+	benchmark.throughput(std::string("ephemeris_kernels/moon/") + EphemerisKernels::instruction_set(), KERNEL_BLOCK,
+		[&]()
+		{
+			EphemerisKernels::moon_inertial_coordinates(kernel_times.data(), KERNEL_BLOCK, kernel_x, kernel_y,
+				kernel_z);
+			return kernel_x[0];
+		}
+	);
+	// Fitted over the days of the epochs (`INPUTS` 5 days apart), as `tide_series` fits one over a dense series
+	ChebyshevEphemeris chebyshev_ephemeris(modified_julian_date, 5 * INPUTS);
+	benchmark.latency("chebyshev_ephemeris/sun",
+		[&](std::size_t index)
+		{
+			return chebyshev_ephemeris.sun_inertial_coordinates(kernel_times[index & (KERNEL_BLOCK - 1)])[X];
+		}
+	);
+	benchmark.latency("chebyshev_ephemeris/moon",
+		[&](std::size_t index)
+		{
+			return chebyshev_ephemeris.moon_inertial_coordinates(kernel_times[index & (KERNEL_BLOCK - 1)])[X];
+		}
+	);
+	benchmark.throughput("chebyshev_ephemeris/fit_30_days", 30,
+		[&](){ return ChebyshevEphemeris(modified_julian_date, 30).lunar_fit_error(); });
+
+	// Corrections
+	benchmark.latency("station_frame",
+		[&](std::size_t index){ return StationFrame(geolocations[index & MASK]).cos_ϕ; });
+	benchmark.latency("step1/mantle_inelasticity_1st_diurnal_band",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK;
+			return geolocations[input].mantle_inelasticity_1st_diurnal_band_correction(station_frames[input],
+				solar_coordinates[input], lunar_coordinates[input], solar_factors[input], lunar_factors[input])[X];
+		}
+	);
+	benchmark.latency("step1/mantle_inelasticity_semi_diurnal_band",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK;
+			return geolocations[input].mantle_inelasticity_semi_diurnal_band_correction(station_frames[input],
+				solar_coordinates[input], lunar_coordinates[input], solar_factors[input], lunar_factors[input])[X];
+		}
+	);
+	benchmark.latency("step1/latitude_dependence",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK;
+			return geolocations[input].latitude_dependence_correction(station_frames[input], solar_coordinates[input],
+				lunar_coordinates[input], solar_factors[input], lunar_factors[input])[X];
+		}
+	);
+	benchmark.latency("step2/diurnal_band",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK;
+			return geolocations[input].second_step_diurnal_band_correction(station_frames[input],
+				epoch_contexts[(index >> 6) & MASK])[X];
+		}
+	);
+	benchmark.latency("step2/longitudinal",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK;
+			return geolocations[input].second_step_longitudinal_correction(station_frames[input],
+				epoch_contexts[(index >> 6) & MASK])[X];
+		}
+	);
+
+	// Whole tide
+	benchmark.latency("tide/julian_date",
+		[&](std::size_t index)
+		{
+			return geolocations[index & MASK].tide(modified_julian_date, julian_dates[index & MASK])[X];
+		}
+	);
+	benchmark.latency("tide/epoch_context",
+		[&](std::size_t index){ return geolocations[index & MASK].tide(epoch_contexts[(index >> 6) & MASK])[X]; });
+	benchmark.latency("tide/shared_ephemerides",
+		[&](std::size_t index)
+		{
+			std::size_t input = index & MASK, epoch = (index >> 6) & MASK;
+			return geolocations[input].tide(epoch_contexts[epoch], station_frames[input], solar_coordinates[epoch],
+				lunar_coordinates[epoch])[X];
+		}
+	);
+
+	// Batches
+	const std::size_t day = 86401;
+	std::vector<double> x(day), y(day), z(day);
+	benchmark.throughput("batch/tide_series/1_day_1s", day,
+		[&]()
+		{
+			geolocations[7].tide_series(modified_julian_date, 0.0, 1.0, day, x.data(), y.data(), z.data());
+			return x[day / 2];
+		}
+	);
+	ThreadPool thread_pool;
+	benchmark.throughput("batch/tide_series/1_day_1s/threads", day,
+		[&]()
+		{
+			geolocations[7].tide_series(modified_julian_date, 0.0, 1.0, day, x.data(), y.data(), z.data(), thread_pool);
+			return x[day / 2];
+		}
+	);
+	benchmark.throughput("batch/job_planner/64_stations_1_day_60s", INPUTS * 1441,
+		[&]()
+		{
+			JobPlanner job_planner;
+			for(std::size_t index = 0; index < INPUTS; index++)
+			{
+				std::size_t station = job_planner.station(-80.0 + 160.0 * index / INPUTS, 5.625 * index, 0.0);
+				job_planner.request(station, modified_julian_date, 0.0, 60.0, 1441);
+			}
+			double sum = 0.0;
+			job_planner.run(thread_pool,
+				[&](std::size_t, std::size_t, std::size_t count, const double* x, const double*, const double*)
+				{
+					sum += x[count - 1];
+				}
+			);
+			return sum;
+		}
+	);
+
+	std::vector<MicroBenchmark::Result> baseline;
+	if(!baseline_path.empty())
+	{
+		baseline = MicroBenchmark::read(baseline_path);
+	}
+	std::cout << benchmark.report(baseline);
+	std::cout << "threads: " << thread_pool.size() << ", ephemeris kernels: " << EphemerisKernels::instruction_set()
+		<< ", sink: " << benchmark.sink() << "\n";
+	if(!output.empty())
+	{
+		benchmark.write(output);
+	}
+	return 0;
+}
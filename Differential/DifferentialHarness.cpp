@@ -0,0 +1,501 @@
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+#include <unistd.h>
+
+
+#include "ChebyshevEphemeris.hpp"
+#include "Coordinate.hpp"
+#include "Datetime.hpp"
+#include "EphemerisKernels.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+#include "UniformEpochs.hpp"
+
+
+static const char USAGE[] =
+	"Usage: SolidEarthTideDifferential [--reference PATH] [--cases N] [--seed N] [--tolerance-um MICROMETERS]\n"
+	"         [--threads N]\n";
+
+static const std::size_t SAMPLES = 60 * 24 + 1;  // solid.f's `do iloop=0,60*24`
+
+
+struct Case
+{
+	unsigned int year, month, day;
+	double latitude_degrees, longitude_degrees;  // As solid.f reads them, in [-360, +360]
+};
+
+
+/*
+The ways the port evaluates solid.f's day. `SCALAR` evaluates every epoch's context, sun & moon directly, as solid.f
+ does; each of the others replaces part of it by an optimization & must stay within the tolerance of it.
+*/
+enum class Path
+{
+	SCALAR,  // `tide(epoch_context)` per epoch
+	KERNELS,  // Direct contexts; the sun & moon of the `EphemerisKernels`
+	CHEBYSHEV,  // Direct contexts; the sun & moon of a `ChebyshevEphemeris` over the day, as `tide_series` fits one
+	RECURRENCE,  // Contexts advanced by `UniformEpochs`; the scalar sun & moon
+	ANGLE_ADDITION,  // Direct contexts; the moon in `Geolocation::LunarSeries::ANGLE_ADDITION` form
+	SERIES,  // `tide_series`: the recurrence & the kernels
+	THREADED_SERIES,  // `tide_series` on the thread pool
+	COUNT
+};
+
+static const char* const PATH_NAMES[] = {"scalar", "kernels", "chebyshev", "recurrence", "angle addition",
+	"tide_series", "tide_series, pool"};
+
+
+struct Series
+{
+	unsigned int modified_julian_date;
+	double step_seconds;
+	std::size_t count;
+};
+
+
+/*
+Long series that `tide_series` must follow: a 2017 day by the minute, 200000 seconds, 200000 half minutes & 200000
+ hours. All but the hourly one are dense enough for its `ChebyshevEphemeris`; all go through the `UniformEpochs`
+ recurrence.
+*/
+static const Series LONG_SERIES[] = {{57754 + 180, 60.0, SAMPLES}, {51000, 1.0, 200000}, {58849, 30.0, 200000},
+	{45000, 3600.0, 200000}};
+
+
+/*
+The largest distance [m] of the `EphemerisKernels`' sun & moon from the scalar series, over `DEVIATION_EPOCHS` epochs
+ spread over the centuries solid.f accepts (1901–2099). Measured at 3.1 cm & 1.0 mm (scalar & AVX2 lanes) & at 4.9 cm
+ & 1.3 mm (AVX-512, whose unit GCC compiles with fused multiply adds); mostly the scalar series' own rounding of angles of
+ up to 10⁵°. The tide moves about 2e-12 m per metre of the sun & 2e-9 m per metre of the moon, so the bounds keep the
+ kernels' share of it under 1e-5 µm.
+*/
+static const double SUN_DEVIATION_BOUND = 0.1;
+static const double MOON_DEVIATION_BOUND = 0.005;
+static const std::size_t DEVIATION_EPOCHS = 1 << 20;
+
+
+static std::vector<Case> random_cases(std::size_t count, unsigned long long seed)
+/*
+Stations anywhere solid.f accepts them, on days of the years it accepts (days 1–28, so every one is a real date).
+*/
+{
+	std::mt19937_64 generator(seed);
+	std::uniform_int_distribution<unsigned int> year(1901, 2099), month(1, 12), day(1, 28);
+	std::uniform_real_distribution<double> latitude(-90.0, 90.0), longitude(-360.0, 360.0);
+	std::vector<Case> cases(count);
+	for(Case& entry : cases)
+	{
+		entry = Case{year(generator), month(generator), day(generator), latitude(generator), longitude(generator)};
+	}
+	return cases;
+}
+
+
+static void evaluate(Case entry, Path path, double* north, double* east, double* up, ThreadPool& thread_pool)
+/*
+solid.f's driver as `main` runs it (SolidEarthTide.cpp), along `path`: the longitude goes through
+ `Geolocation::east_longitude`, as `main`'s does, so the random longitudes in [-360, +360] check `main`'s
+ normalization against solid.f's as well.
+*/
+{
+	entry.longitude_degrees = Geolocation::east_longitude(entry.longitude_degrees);
+	Geolocation location(entry.latitude_degrees, entry.longitude_degrees);
+
+	JulianDate julian_date = (JulianDate)Datetime(entry.year, entry.month, entry.day);
+	Datetime normalized_datetime = (Datetime)julian_date;
+	unsigned int initial_modified_julian_date = ((JulianDate)normalized_datetime).modified_julian_date();
+	double fractional_modified_julian_date = julian_date.fractional_modified_julian_date();
+	std::vector<double> x(SAMPLES), y(SAMPLES), z(SAMPLES);
+	if(path == Path::SERIES || path == Path::THREADED_SERIES)
+	{
+		if(path == Path::THREADED_SERIES)
+		{
+			location.tide_series(initial_modified_julian_date, fractional_modified_julian_date, 60.0, SAMPLES,
+				x.data(), y.data(), z.data(), thread_pool);
+		}
+		else
+		{
+			location.tide_series(initial_modified_julian_date, fractional_modified_julian_date, 60.0, SAMPLES,
+				x.data(), y.data(), z.data());
+		}
+		location.local_horizon(SAMPLES, x.data(), y.data(), z.data(), north, east, up);
+		return;
+	}
+
+	// The epochs `tide_series` evaluates, each with its own day's leap second
+	UniformEpochs uniform_epochs(initial_modified_julian_date, fractional_modified_julian_date, 60.0);
+	std::vector<EpochContext> epoch_contexts;
+	epoch_contexts.reserve(SAMPLES);
+	if(path == Path::RECURRENCE)
+	{
+		uniform_epochs.epochs(0, SAMPLES, epoch_contexts);
+	}
+	else
+	{
+		for(std::size_t sample = 0; sample < SAMPLES; sample++)
+		{
+			JulianDate sample_date = uniform_epochs.julian_date(sample);
+			epoch_contexts.push_back(EpochContext(sample_date.modified_julian_date(), sample_date));
+		}
+	}
+
+	std::vector<double> terrestrial_time(SAMPLES), solar[3], lunar[3];
+	if(path == Path::KERNELS)
+	{
+		for(std::size_t sample = 0; sample < SAMPLES; sample++)
+		{
+			terrestrial_time[sample] = epoch_contexts[sample].julian_centuries;
+		}
+		for(unsigned int component = 0; component < 3; component++)
+		{
+			solar[component].resize(SAMPLES);
+			lunar[component].resize(SAMPLES);
+		}
+		EphemerisKernels::sun_inertial_coordinates(terrestrial_time.data(), SAMPLES, solar[X].data(), solar[Y].data(),
+			solar[Z].data());
+		EphemerisKernels::moon_inertial_coordinates(terrestrial_time.data(), SAMPLES, lunar[X].data(),
+			lunar[Y].data(), lunar[Z].data());
+	}
+
+	std::unique_ptr<ChebyshevEphemeris> chebyshev_ephemeris;
+	if(path == Path::CHEBYSHEV)
+	{
+		chebyshev_ephemeris.reset(new ChebyshevEphemeris(initial_modified_julian_date, 2));
+	}
+
+	StationFrame station_frame(location);
+	for(std::size_t sample = 0; sample < SAMPLES; sample++)
+	{
+		const EpochContext& epoch_context = epoch_contexts[sample];
+		Coordinate<double> displacement;
+		if(path == Path::CHEBYSHEV)
+		{
+			Coordinate<double> solar_coordinate = chebyshev_ephemeris->sun_coordinates(epoch_context);
+			Coordinate<double> lunar_coordinate = chebyshev_ephemeris->moon_coordinates(epoch_context);
+			displacement = location.tide(epoch_context, station_frame, solar_coordinate, lunar_coordinate);
+		}
+		else if(path == Path::KERNELS)
+		{
+			double sine = epoch_context.sin_greenwich_hour_angle, cosine = epoch_context.cos_greenwich_hour_angle;
+			Coordinate<double> solar_coordinate = Coordinate<double>(solar[X][sample], solar[Y][sample],
+				solar[Z][sample]).rotate3(sine, cosine);
+			Coordinate<double> lunar_coordinate = Coordinate<double>(lunar[X][sample], lunar[Y][sample],
+				lunar[Z][sample]).rotate3(sine, cosine);
+			displacement = location.tide(epoch_context, station_frame, solar_coordinate, lunar_coordinate);
+		}
+		else
+		{
+			displacement = location.tide(epoch_context, path == Path::ANGLE_ADDITION
+				? Geolocation::LunarSeries::ANGLE_ADDITION : Geolocation::LunarSeries::DIRECT);
+		}
+		x[sample] = displacement[X];
+		y[sample] = displacement[Y];
+		z[sample] = displacement[Z];
+	}
+	location.local_horizon(SAMPLES, x.data(), y.data(), z.data(), north, east, up);
+}
+
+
+static double evaluate_all(const std::vector<Case>& cases, Path path, std::vector<double> (&tide)[3],
+	ThreadPool& thread_pool
+)
+/*
+Every case along `path` into `tide` (north, east, up, each case's `SAMPLES` after the previous one's); the seconds it
+ took.
+*/
+{
+	for(std::vector<double>& component : tide)
+	{
+		component.resize(cases.size() * SAMPLES);
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(std::size_t index = 0; index < cases.size(); index++)
+	{
+		evaluate(cases[index], path, &tide[0][index * SAMPLES], &tide[1][index * SAMPLES], &tide[2][index * SAMPLES],
+			thread_pool);
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+static double series_difference(const Series& series)
+/*
+The largest difference [µm] of any component between `tide_series` (the `UniformEpochs` recurrence & the
+ `EphemerisKernels` or a `ChebyshevEphemeris`) & `tide()` evaluating every sample directly, at a station whose tide is
+ near its largest.
+*/
+{
+	Geolocation location(0.0, 0.0);
+	std::vector<double> x(series.count), y(series.count), z(series.count);
+	location.tide_series(series.modified_julian_date, 0.0, series.step_seconds, series.count, x.data(), y.data(),
+		z.data());
+
+	UniformEpochs uniform_epochs(series.modified_julian_date, 0.0, series.step_seconds);
+	double largest = 0.0;
+	for(std::size_t sample = 0; sample < series.count; sample++)
+	{
+		JulianDate julian_date = uniform_epochs.julian_date(sample);
+		Coordinate<double> direct = location.tide(EpochContext(julian_date.modified_julian_date(), julian_date));
+		double difference = std::max(std::fabs(direct[X] - x[sample]), std::max(std::fabs(direct[Y] - y[sample]),
+			std::fabs(direct[Z] - z[sample]))) * 1e6;
+		largest = std::isnan(difference) ? INFINITY : std::max(largest, difference);
+	}
+	return largest;
+}
+
+
+static double number(const char* text)
+{
+	char* end;
+	double value = std::strtod(text, &end);
+	if(end == text || *end)
+	{
+		throw std::runtime_error(std::string("Expected a number, not '") + text + "'");
+	}
+	return value;
+}
+
+
+int main(int argument_count, char* arguments[])
+/*
+`make differential`: runs solid.f (`solid_reference`, Differential/ReferenceDriver.f) & this port over the same random
+ stations & days, reports the median & largest north, east & up differences [µm] & each one's evaluations per
+ second. Then follows `LONG_SERIES` with `tide_series` & with direct evaluation, & checks the `EphemerisKernels` against
+ the scalar series. Exits with 1 when a difference is over the tolerance (or a kernel over its bound), so that an
+ optimization has to show both.
+*/
+{
+	std::string reference = "./solid_reference";
+	std::size_t case_count = 200;
+	unsigned long long seed = 1;
+	double tolerance_micrometers = 1.0;
+	unsigned int threads = 0;
+	try
+	{
+		for(int index = 1; index < argument_count; index += 2)
+		{
+			std::string flag = arguments[index];
+			if(index + 1 == argument_count)
+			{
+				throw std::runtime_error("Missing value for " + flag);
+			}
+			if(flag == "--reference")
+			{
+				reference = arguments[index + 1];
+			}
+			else if(flag == "--cases")
+			{
+				case_count = static_cast<std::size_t>(number(arguments[index + 1]));
+			}
+			else if(flag == "--seed")
+			{
+				seed = static_cast<unsigned long long>(number(arguments[index + 1]));
+			}
+			else if(flag == "--tolerance-um")
+			{
+				tolerance_micrometers = number(arguments[index + 1]);
+			}
+			else if(flag == "--threads")
+			{
+				threads = static_cast<unsigned int>(number(arguments[index + 1]));
+			}
+			else
+			{
+				throw std::runtime_error("Unexpected argument '" + flag + "'");
+			}
+		}
+	}
+	catch(std::exception& error)
+	{
+		std::cerr << error.what() << "\n" << USAGE;
+		return 2;
+	}
+
+	std::vector<Case> cases = random_cases(case_count, seed);
+	char directory[] = "/tmp/solid-differential-XXXXXX";
+	if(!mkdtemp(directory))
+	{
+		std::cerr << "Unable to create a temporary directory\n";
+		return 2;
+	}
+	std::string cases_path = std::string(directory) + "/cases.txt";
+	std::string reference_path = std::string(directory) + "/reference.bin";
+	{
+		std::FILE* file = std::fopen(cases_path.c_str(), "w");
+		for(const Case& entry : cases)
+		{
+			std::fprintf(file, "%u %u %u %.17g %.17g\n", entry.year, entry.month, entry.day, entry.latitude_degrees,
+				entry.longitude_degrees);
+		}
+		std::fclose(file);
+	}
+
+	// Reference
+	double reference_seconds = NAN;
+	std::string command = "'" + reference + "' '" + cases_path + "' '" + reference_path + "'";
+	std::FILE* process = popen(command.c_str(), "r");
+	if(!process || std::fscanf(process, "%lf", &reference_seconds) != 1 || pclose(process) != 0)
+	{
+		std::cerr << "Unable to run the reference " << reference << " (make solid_reference)\n";
+		return 2;
+	}
+	std::vector<double> reference_tide(cases.size() * SAMPLES * 3);
+	{
+		std::ifstream file(reference_path, std::ios::binary);
+		file.read(reinterpret_cast<char*>(reference_tide.data()), reference_tide.size() * sizeof(double));
+		if(file.gcount() != static_cast<std::streamsize>(reference_tide.size() * sizeof(double)))
+		{
+			std::cerr << "The reference wrote " << file.gcount() << " bytes, not " << reference_tide.size() * 8 << "\n";
+			return 2;
+		}
+	}
+	std::remove(cases_path.c_str());
+	std::remove(reference_path.c_str());
+	rmdir(directory);
+
+	// The port along every path, each one thread at a time except the pool's
+	ThreadPool thread_pool(threads);
+	const std::size_t PATHS = static_cast<std::size_t>(Path::COUNT);
+	std::vector<double> port[PATHS][3];
+	double port_seconds[PATHS];
+	for(std::size_t path = 0; path < PATHS; path++)
+	{
+		port_seconds[path] = evaluate_all(cases, static_cast<Path>(path), port[path], thread_pool);
+	}
+	const std::vector<double> (&scalar)[3] = port[static_cast<std::size_t>(Path::SCALAR)];
+
+	// Baseline: the scalar path against solid.f
+	const char* names[3] = {"north", "east", "up"};
+	double largest[3] = {0.0, 0.0, 0.0};
+	std::size_t largest_sample[3] = {0, 0, 0};
+	std::vector<double> differences[3];
+	std::size_t over_tolerance = 0;
+	for(std::size_t sample = 0; sample < scalar[0].size(); sample++)
+	{
+		bool over = false;
+		for(unsigned int component = 0; component < 3; component++)
+		{
+			double difference = std::fabs(scalar[component][sample] - reference_tide[sample * 3 + component]) * 1e6;
+			differences[component].push_back(std::isnan(difference) ? INFINITY : difference);
+			if(!(difference <= largest[component]))
+			{
+				largest[component] = std::isnan(difference) ? INFINITY : difference;
+				largest_sample[component] = sample;
+			}
+			over |= !(difference <= tolerance_micrometers);
+		}
+		over_tolerance += over;
+	}
+
+	double evaluations = static_cast<double>(scalar[0].size());
+	std::printf("%zu stations & days (seed %llu), %zu epochs each: %.0f evaluations\n", cases.size(), seed, SAMPLES,
+		evaluations);
+	std::printf("baseline, the port's scalar path against solid.f:\n");
+	for(unsigned int component = 0; component < 3; component++)
+	{
+		std::vector<double>& component_differences = differences[component];
+		std::size_t median = component_differences.empty() ? 0 : (component_differences.size() - 1) / 2;
+		std::nth_element(component_differences.begin(), component_differences.begin() + median,
+			component_differences.end());
+		const Case& entry = cases[largest_sample[component] / SAMPLES];
+		std::size_t minutes = largest_sample[component] % SAMPLES;
+		std::printf("  %-5s difference: median %12.3e µm, largest %12.3e µm "
+			"(%04u-%02u-%02u %02zu:%02zu at %.6f, %.6f)\n", names[component],
+			component_differences.empty() ? 0.0 : component_differences[median], largest[component], entry.year,
+			entry.month, entry.day, minutes / 60, minutes % 60, entry.latitude_degrees, entry.longitude_degrees);
+	}
+	std::printf("  epochs over %.3f µm: %zu of %.0f\n", tolerance_micrometers, over_tolerance, evaluations);
+
+	// Optimizations: every other path against the scalar one
+	std::printf("optimized paths against the scalar path:\n");
+	std::size_t paths_over_tolerance = 0;
+	for(std::size_t path = 1; path < PATHS; path++)
+	{
+		double path_largest[3] = {0.0, 0.0, 0.0};
+		std::size_t path_over_tolerance = 0;
+		for(std::size_t sample = 0; sample < scalar[0].size(); sample++)
+		{
+			bool over = false;
+			for(unsigned int component = 0; component < 3; component++)
+			{
+				double difference = std::fabs(port[path][component][sample] - scalar[component][sample]) * 1e6;
+				path_largest[component] = std::isnan(difference) ? INFINITY
+					: std::max(path_largest[component], difference);
+				over |= !(difference <= tolerance_micrometers);
+			}
+			path_over_tolerance += over;
+		}
+		paths_over_tolerance += path_over_tolerance;
+		std::printf("  %-17s largest %.2e µm north, %.2e µm east, %.2e µm up; %zu epochs over %.3f µm\n",
+			PATH_NAMES[path], path_largest[0], path_largest[1], path_largest[2], path_over_tolerance,
+			tolerance_micrometers);
+	}
+
+	// Chunks of the pool start on anchors & kernel blocks, so the pool must give the serial series exactly
+	bool pool_identical = true;
+	for(unsigned int component = 0; component < 3; component++)
+	{
+		pool_identical &= port[static_cast<std::size_t>(Path::THREADED_SERIES)][component]
+			== port[static_cast<std::size_t>(Path::SERIES)][component];
+	}
+	paths_over_tolerance += !pool_identical;
+	std::printf("  tide_series, pool %s the serial tide_series\n", pool_identical ? "is identical to" : "differs from");
+
+	std::size_t series_over_tolerance = 0;
+	for(const Series& series : LONG_SERIES)
+	{
+		double difference = series_difference(series);
+		series_over_tolerance += !(difference <= tolerance_micrometers);
+		std::printf("  tide_series, %6zu × %4.0f s from MJD %u: largest %.2e µm from direct evaluation\n",
+			series.count, series.step_seconds, series.modified_julian_date, difference);
+	}
+
+	std::vector<double> terrestrial_times(DEVIATION_EPOCHS);
+	for(std::size_t index = 0; index < DEVIATION_EPOCHS; index++)
+	{
+		// Julian centuries of TT from J2000: 1901-01-01 is -0.99, 2099-12-31 is 1.0
+		terrestrial_times[index] = -0.99 + 1.99 * (static_cast<double>(index) + 0.5) / DEVIATION_EPOCHS;
+	}
+	double sun_deviation = EphemerisKernels::sun_deviation(terrestrial_times.data(), DEVIATION_EPOCHS);
+	double moon_deviation = EphemerisKernels::moon_deviation(terrestrial_times.data(), DEVIATION_EPOCHS);
+	bool kernels_over_bound = !(sun_deviation <= SUN_DEVIATION_BOUND) || !(moon_deviation <= MOON_DEVIATION_BOUND);
+	std::printf("  %s kernels (%u lane%s), %zu epochs 1901–2099: sun within %.2e m (bound %.0e m), moon within %.2e m "
+		"(bound %.0e m)\n", EphemerisKernels::instruction_set(), EphemerisKernels::lanes(),
+		EphemerisKernels::lanes() == 1 ? "" : "s", DEVIATION_EPOCHS, sun_deviation, SUN_DEVIATION_BOUND, moon_deviation,
+		MOON_DEVIATION_BOUND);
+
+	std::printf("solid.f                       %12.0f evaluations/s\n", evaluations / reference_seconds);
+	const Path timed[] = {Path::SCALAR, Path::SERIES, Path::THREADED_SERIES};
+	for(Path path : timed)
+	{
+		std::size_t index = static_cast<std::size_t>(path);
+		unsigned int path_threads = path == Path::THREADED_SERIES ? thread_pool.size() : 1;
+		std::printf("port, %-17s %2u thread%s %12.0f evaluations/s  (%.2fx solid.f)\n", PATH_NAMES[index],
+			path_threads, path_threads == 1 ? " " : "s", evaluations / port_seconds[index],
+			reference_seconds / port_seconds[index]);
+	}
+
+	std::printf("%s\n", over_tolerance ? "FAIL: the scalar path is outside the tolerance of solid.f"
+		: paths_over_tolerance ? "FAIL: an optimized path is outside the tolerance of the scalar path"
+		: series_over_tolerance ? "FAIL: a long tide_series is outside the tolerance of direct evaluation"
+		: kernels_over_bound ? "FAIL: the ephemeris kernels are outside their bounds of the scalar series" : "PASS");
+	return over_tolerance || paths_over_tolerance || series_over_tolerance || kernels_over_bound ? 1 : 0;
+}
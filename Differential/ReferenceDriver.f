@@ -0,0 +1,99 @@
+      program refdrv
+
+*** differential harness reference: solid.f's driver loop, unchanged,
+*** for every case of a file instead of one typed in.  linked with
+*** solid.f's subroutines (make differential strips its main program).
+***
+*** usage: solid_reference CASES OUTPUT
+***   CASES   one case per line:  iyr imo idy glad glod
+***   OUTPUT  stream of float64 ut,vt,wt (north, east, up [m]) for the
+***           1441 one-minute epochs of each case, in host byte order
+*** writes the seconds spent in the loop (not reading or writing) to
+*** standard output.
+
+      implicit double precision(a-h,o-z)
+      dimension rsun(3),rmoon(3),etide(3),xsta(3)
+      dimension tide(3,0:60*24)
+      logical lflag                    !*** leap second table limit flag
+      character*1024 cases,output
+      integer*8 icount,irate,istart,istop,iticks
+      common/stuff/rad,pi,pi2
+      common/comgrs/a,e2
+
+*** constants
+
+      pi=4.d0*datan(1.d0)
+      pi2=pi+pi
+      rad=180.d0/pi
+
+*** grs80
+
+      a=6378137.d0
+      e2=6.69438002290341574957d-03
+
+      call get_command_argument(1,cases)
+      call get_command_argument(2,output)
+      open(10,file=cases,form='formatted',status='old')
+      open(11,file=output,form='unformatted',access='stream',
+     *     status='replace')
+
+      iticks=0
+      call system_clock(icount,irate)
+   10 read(10,*,end=90) iyr,imo,idy,glad,glod
+      call system_clock(istart)
+
+*** position of observing point (positive East)
+
+      if(glod.lt.  0.d0) glod=glod+360.d0
+      if(glod.ge.360.d0) glod=glod-360.d0
+
+      gla0=glad/rad
+      glo0=glod/rad
+      eht0=0.d0
+      call geoxyz(gla0,glo0,eht0,x0,y0,z0)
+      xsta(1)=x0
+      xsta(2)=y0
+      xsta(3)=z0
+
+*** here comes the sun  (and the moon)  (go, tide!)
+
+      ihr=   0
+      imn=   0
+      sec=0.d0                                         !*** UTC time system
+      call civmjd(iyr,imo,idy,ihr,imn,sec,mjd,fmjd)
+      call mjdciv(mjd,fmjd,iyr,imo,idy,ihr,imn,sec)    !*** normalize civil time
+      call setjd0(iyr,imo,idy)
+
+      tdel2=1.d0/60.d0/24.d0                           !*** 1 minute steps
+      do iloop=0,60*24
+        lflag=.false.                           !*** false means flag not raised
+        call sunxyz (mjd,fmjd,rsun,lflag)                   !*** mjd/fmjd in UTC
+        call moonxyz(mjd,fmjd,rmoon,lflag)                  !*** mjd/fmjd in UTC
+        call detide (xsta,mjd,fmjd,rsun,rmoon,etide,lflag)  !*** mjd/fmjd in UTC
+        xt = etide(1)
+        yt = etide(2)
+        zt = etide(3)
+
+*** determine local geodetic horizon components (topocentric)
+
+        call rge(gla0,glo0,ut,vt,wt,xt,   yt,   zt)       !*** tide vector
+        tide(1,iloop)=ut
+        tide(2,iloop)=vt
+        tide(3,iloop)=wt
+
+        call mjdciv(mjd,fmjd               +0.001d0/86400.d0,
+     *              iyr,imo,idy,ihr,imn,sec-0.001d0)
+
+        fmjd=fmjd+tdel2
+        fmjd=(idnint(fmjd*86400.d0))/86400.d0      !*** force 1 sec. granularity
+      enddo
+
+      call system_clock(istop)
+      iticks=iticks+(istop-istart)
+      write(11) tide
+      go to 10
+
+   90 close(10)
+      close(11)
+      write(*,'(f16.9)') dble(iticks)/dble(irate)
+      end
@@ -0,0 +1,126 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+#include "TideSeriesFile.hpp"
+
+
+class StationCatalog;
+
+
+class BatchJob
+/*
+A non-interactive run: tide series for any number of stations & time ranges, all in one process. Settings
+ come from command line flags (`--key value`) and/or job files (`key value` per line, `#` comments), applied in order so
+ that later flags override a job file's settings; every `station` adds a station.
+
+| key          | value                                      | default                            |
+|--------------|--------------------------------------------|------------------------------------|
+| job          | path of a job file to read at this point   |                                    |
+| station      | latitude, longitude [, height [, name]]    | height 0 m, name `station<number>` |
+| catalog      | `StationCatalog` (CSV or binary) to add    |                                    |
+| start        | UTC `YYYY-MM-DD[Thh:mm[:ss]]`              | required                           |
+| end          | UTC `YYYY-MM-DD[Thh:mm[:ss]]`, inclusive   | start + 1 day (as solid.f)         |
+| step         | seconds                                    | 60                                 |
+| format       | `text` (solid.txt lines) or `binary`       | text                               |
+| frame        | `enu` or `ecef` (binary only)              | enu                                |
+| output       | directory for `<name>.txt` / `<name>.tide` | .                                  |
+| threads      | worker threads, 0 for one per hardware one | 0                                  |
+| leap-seconds | IERS `Leap_Second.dat` replacing the table | built in                           |
+| series       | station name, start, end [, step [, name]] | step `step`, name `<station>-<n>`  |
+| serve        | Unix socket path to answer queries on      |                                    |
+| coalesce-us  | `TideServer` batching window, microseconds | 0                                  |
+
+Station fields may be separated by commas or spaces; latitudes & longitudes are degrees (north & east), heights meters
+ above the ellipsoid. Without `series`, every station is computed over `start`–`end` into `<station>`; with them, only
+ the series are computed, each into its own name. Either way they all go through one `JobPlanner`, so series that
+ overlap at a station are evaluated once, stations over the same epochs share their sun & moon, and results are written
+ a chunk at a time. Text output starts every UTC day of a series with its own `year,month,day=` header & counts that
+ day's seconds, as solid.f writes its one day, so series of any length keep within its f8.1 time column.
+With `serve`, nothing is computed up front: a `TideServer` answers queries on the socket until SIGINT or SIGTERM, using
+ `threads`, `coalesce-us` & `leap-seconds` only.
+*/
+{
+	public:
+		enum class Format
+		{
+			TEXT,  // `SolidTextWriter`
+			BINARY  // `TideSeriesFile`
+		};
+
+		struct Station
+		/*
+		A station holds no name of its own: it is indexed by its position in the catalog it came from (or in the names
+		 of `station` settings), which keeps the name until `BatchJob::name()` asks for it.
+		*/
+		{
+			std::size_t catalog;  // In `_catalogs`, or `SETTING` for a `station` setting
+			std::size_t position;  // In the catalog, or in `_station_names`
+			double latitude_degrees;
+			double longitude_degrees;  // [0, 360)
+			double height_meters;
+		};
+
+		static const char USAGE[];
+		static const std::size_t SETTING;  // `Station::catalog` of a station from a `station` setting
+
+		BatchJob(int argument_count, char* arguments[]);
+		BatchJob(const BatchJob&) = delete;
+		BatchJob& operator=(const BatchJob&) = delete;
+		~BatchJob();
+
+		void run();
+
+	private:
+		struct Series
+		{
+			std::string name;  // Empty for the station's own series, which is named after the station
+			std::size_t station;  // In `_stations`
+			unsigned int modified_julian_date;
+			double start_seconds;  // From the start of `modified_julian_date`
+			double step_seconds;
+			std::size_t count;
+		};
+
+		void add(std::size_t catalog, std::size_t position, double latitude_degrees, double longitude_degrees,
+			double height_meters
+		);
+		std::string name(std::size_t station) const;
+		void index_names();
+		std::size_t find(const std::string& station_name) const;
+		static std::uint64_t hash(const std::string& name);
+		void set(const std::string& key, const std::string& value);
+		void read(const std::string& path);
+		static void epoch(const std::string& value, unsigned int& modified_julian_date, double& seconds);
+		static std::size_t count(unsigned int start_modified_julian_date, double start_seconds,
+			unsigned int end_modified_julian_date, double end_seconds, double step_seconds
+		);
+
+		std::vector<Station> _stations;
+		std::vector<std::unique_ptr<StationCatalog>> _catalogs;  // Kept mapped for the stations' names
+		std::vector<std::string> _station_names;  // Of `station` settings, empty if none was given
+		std::vector<std::pair<std::uint64_t, std::size_t>> _name_index;  // (`hash(name(station))`, station), sorted
+		std::vector<std::string> _series;  // `series` values, resolved by `run()` once all stations are known
+		bool _has_start;
+		unsigned int _start_modified_julian_date;
+		double _start_seconds;  // From the start of `_start_modified_julian_date`
+		bool _has_end;
+		unsigned int _end_modified_julian_date;
+		double _end_seconds;
+		double _step_seconds;
+		Format _format;
+		TideSeriesFile::Frame _frame;
+		std::string _output;
+		unsigned int _threads;
+		std::string _serve;  // Socket path
+		unsigned int _coalesce_microseconds;
+};
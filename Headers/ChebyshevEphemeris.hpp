@@ -0,0 +1,68 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+
+
+class EpochContext;
+class JulianDate;
+
+
+class ChebyshevEphemeris
+/*
+Piecewise Chebyshev approximation of `Geolocation::sun_inertial_coordinates` & `Geolocation::moon_inertial_coordinates`
+ over a fixed span of days. Each component of each body is fitted per segment at the Chebyshev nodes, then evaluated by
+ Clenshaw recurrence (the three components together); only the Greenwich hour angle rotation (`rot3`) is left per epoch.
+ `Geolocation::tide_series` uses one for series dense enough to repay the fit.
+The nodes are evaluated by the `EphemerisKernels`, & the fit is checked against the direct series between the nodes
+ when it is built, so that the largest deviation found (`solar_fit_error`, `lunar_fit_error`) includes the kernels'
+ own. The constructor throws if it exceeds the tolerance for either body. Evaluation is const, so that threads may
+ share one.
+*/
+{
+	public:
+		static const double SOLAR_SEGMENT_DAYS;  // 8 days
+		static const double LUNAR_SEGMENT_DAYS;  // 1 day
+		static const unsigned int SOLAR_DEGREE;
+		static const unsigned int LUNAR_DEGREE;
+		static const double SOLAR_TOLERANCE;  // Meters
+		static const double LUNAR_TOLERANCE;  // Meters
+
+		ChebyshevEphemeris(unsigned int first_modified_julian_date, unsigned int days);
+
+		Coordinate<double> sun_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date) const;
+		Coordinate<double> moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date) const;
+		Coordinate<double> sun_coordinates(const EpochContext& epoch_context) const;
+		Coordinate<double> moon_coordinates(const EpochContext& epoch_context) const;
+		Coordinate<double> sun_inertial_coordinates(double terrestrial_time) const;
+		Coordinate<double> moon_inertial_coordinates(double terrestrial_time) const;
+
+		double solar_fit_error() const;
+		double lunar_fit_error() const;
+
+	private:
+		struct Segments
+		{
+			double start;  // Julian centuries (TT) of the first segment
+			double length;  // Julian centuries (TT) per segment
+			unsigned int count;
+			unsigned int degree;
+			std::vector<double> coefficients;  // [segment][component][degree + 1]
+			double fit_error;  // Meters
+		};
+
+		typedef void (*Kernel)(const double* terrestrial_time, std::size_t count, double* x, double* y, double* z);
+		typedef Coordinate<double> (*Series)(double terrestrial_time);
+
+		static void fit(Segments& segments, Kernel kernel, Series series);
+		static bool evaluate(const Segments& segments, double terrestrial_time, Coordinate<double>& coordinate);
+
+		Segments _solar;
+		Segments _lunar;
+};
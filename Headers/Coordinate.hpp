@@ -29,14 +29,15 @@ class Coordinate
 
 		Coordinate();
 		Coordinate(T x, T y, T z);
-		T distance();
-		Coordinate<double> geodetic_cartesian_system(double latitude, double longitude);
-		Coordinate<T> rotate1(double theta_radians);
-		Coordinate<T> rotate3(double theta_radians);
+		T distance() const;
+		Coordinate<double> geodetic_cartesian_system(double latitude, double longitude) const;
+		Coordinate<T> rotate1(double theta_radians) const;
+		Coordinate<T> rotate3(double theta_radians) const;
+		Coordinate<T> rotate3(double sin_theta, double cos_theta) const;
 		T operator+(Coordinate<T>& right);
-		Coordinate<T>& operator+=(Coordinate<T>& right);
-		T operator*(Coordinate<T>& right);
-		Coordinate<T> operator/(T right);
+		Coordinate<T>& operator+=(const Coordinate<T>& right);
+		T operator*(const Coordinate<T>& right) const;
+		Coordinate<T> operator/(T right) const;
 		T operator[](unsigned int index) const;
 		T& operator[](unsigned int index);
 
@@ -64,7 +65,7 @@ Coordinate<T>::Coordinate()
 // ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
 
 template<typename T>
-T Coordinate<T>::distance()
+T Coordinate<T>::distance() const
 /*
 solid.f [LN 693–702]
 ```
@@ -86,7 +87,7 @@ solid.f [LN 693–702]
 
 
 template<typename T>
-Coordinate<double> Coordinate<T>::geodetic_cartesian_system(double latitude, double longitude)
+Coordinate<double> Coordinate<T>::geodetic_cartesian_system(double latitude, double longitude) const
 /*
 solid.f [LN 989–992]
 ```
@@ -132,7 +133,7 @@ solid.f [LN 989–992]
 
 
 template<typename T>
-Coordinate<T> Coordinate<T>::rotate1(double theta_radians)
+Coordinate<T> Coordinate<T>::rotate1(double theta_radians) const
 /*
 solid.f [LN 1025–1040]
 ```
@@ -163,7 +164,7 @@ solid.f [LN 1025–1040]
 
 
 template<typename T>
-Coordinate<T> Coordinate<T>::rotate3(double theta_radians)
+Coordinate<T> Coordinate<T>::rotate3(double theta_radians) const
 /*
 solid.f [LN 1025–1040]
 ```
@@ -189,6 +190,17 @@ solid.f [LN 1025–1040]
 	double sin_theta = sin(theta_radians);  // Check if these need to be converted to Radians
 	double cos_theta = cos(theta_radians);  // Check if these need to be converted to Radians
 
+	return rotate3(sin_theta, cos_theta);
+}
+
+
+template<typename T>
+Coordinate<T> Coordinate<T>::rotate3(double sin_theta, double cos_theta) const
+/*
+`rot3` for an angle whose sine & cosine are already known (e.g. the Greenwich hour angle of an `EpochContext`, which is
+ shared by the sun & the moon).
+*/
+{
 	return Coordinate<T>(cos_theta * x + sin_theta * y, cos_theta * y - sin_theta * x, z);
 }
 
@@ -203,7 +215,7 @@ T Coordinate<T>::operator+(Coordinate<T>& right)
 
 
 template<typename T>
-Coordinate<T>& Coordinate<T>::operator+=(Coordinate<T>& right)
+Coordinate<T>& Coordinate<T>::operator+=(const Coordinate<T>& right)
 {
 	x += right.x;
 	y += right.y;
@@ -213,7 +225,7 @@ Coordinate<T>& Coordinate<T>::operator+=(Coordinate<T>& right)
 
 
 template<typename T>
-T Coordinate<T>::operator*(Coordinate<T>& right)
+T Coordinate<T>::operator*(const Coordinate<T>& right) const
 /*
 Dot product
 */
@@ -223,7 +235,7 @@ Dot product
 
 
 template<typename T>
-Coordinate<T> Coordinate<T>::operator/(T right)
+Coordinate<T> Coordinate<T>::operator/(T right) const
 /*
 Dot product
 */
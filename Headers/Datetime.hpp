@@ -28,6 +28,9 @@ class Datetime
 		operator JulianDate();
 
 		unsigned int initial_modified_julian_date();
+		unsigned int year();
+		unsigned int month();
+		unsigned int day();
 
 	private:
 		const unsigned int _year;
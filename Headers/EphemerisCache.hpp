@@ -0,0 +1,70 @@
+
+
+#pragma once
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+#include "Geolocation.hpp"
+
+
+class JulianDate;
+
+
+class EphemerisCache
+/*
+Bounded, direct-mapped memo of `Geolocation::sun_coordinates` & `Geolocation::moon_coordinates` keyed on the epoch. Each
+ epoch hashes to exactly one slot; a query for a different epoch in an occupied slot evicts it. Hit & miss counters are
+ kept per query so that the capacity can be sized against a real workload.
+The leap second lookup depends on the initial MJD as well as on the epoch, so it is part of the key. The moon is
+ evaluated in `lunar_series` form, which should be the one that the uncached path uses (`Geolocation::tide()` uses
+ `LunarSeries::DIRECT`), so that a cached & an uncached evaluation of an epoch agree.
+One cache may be shared by threads: slots are guarded by `LOCKS` striped mutexes that are held only to read or write an
+ entry (never while `sunxyz` or `moonxyz` runs), & the counters are atomic. Two threads that miss the same epoch at once
+ both evaluate it.
+*/
+{
+	public:
+		static const std::size_t LOCKS;  // 64
+
+		EphemerisCache(std::size_t capacity=1024,
+			Geolocation::LunarSeries lunar_series=Geolocation::LunarSeries::DIRECT
+		);
+
+		Coordinate<double> sun_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		Coordinate<double> moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+
+		std::size_t capacity();
+		unsigned long long hits();
+		unsigned long long misses();
+		void clear();
+
+	private:
+		struct Entry
+		{
+			bool has_sun;
+			bool has_moon;
+			unsigned int initial_modified_julian_date;
+			unsigned int modified_julian_date;
+			double fractional_modified_julian_date;
+			Coordinate<double> solar_coordinate;
+			Coordinate<double> lunar_coordinate;
+		};
+
+		Coordinate<double> coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date, bool lunar);
+		std::size_t slot(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		static bool holds(Entry& entry, unsigned int initial_modified_julian_date, JulianDate& julian_date);
+
+		Geolocation::LunarSeries _lunar_series;
+		std::vector<Entry> _entries;  // Size is a power of two, so that the slot index is a mask of the hash
+		std::unique_ptr<std::mutex[]> _locks;  // Slot `index` is guarded by `_locks[index % LOCKS]`
+		std::atomic<unsigned long long> _hits;
+		std::atomic<unsigned long long> _misses;
+};
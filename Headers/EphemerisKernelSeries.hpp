@@ -0,0 +1,225 @@
+
+
+#pragma once
+
+
+#include <cmath>
+#include <cstddef>
+
+
+#include "Geolocation.hpp"
+
+
+/*
+The series of `EphemerisKernels`, written once for any lane type `L`. Each translation unit that includes this defines
+ its own `L` (EphemerisKernels.cpp `ScalarLanes`, EphemerisKernelsAVX2.cpp `AVX2Lanes`, EphemerisKernelsAVX512.cpp
+ `AVX512Lanes`), which wraps one register of doubles with:
+	`Mask`, `WIDTH`, `broadcast`, `load`, `store`, `round` (to nearest), `equal`, `either`, `select` & `+ - *`.
+Their instantiations therefore never share a symbol, & each is compiled for the instruction set of its own unit.
+*/
+
+
+// ———————————————————————————————————————————————————— SINCOS  ———————————————————————————————————————————————————— //
+
+template<typename L>
+void sincos_degrees(L degrees, L& sine, L& cosine)
+/*
+The angle is first reduced to [-180°, 180°] (exact, since 360 & the turn count are exact), then to [-π/4, π/4] about the
+ nearest multiple of π/2 (fdlibm's two part π/2). sin & cos of the remainder are fdlibm's `__kernel_sin` &
+ `__kernel_cos` polynomials; the quadrant picks & negates them.
+*/
+{
+	L turns = L::round(degrees * L::broadcast(1.0 / 360.0));
+	L radians = (degrees - turns * L::broadcast(360.0)) * L::broadcast(static_cast<double>(1.0 / Geolocation::RADIAN));
+
+	L quadrant = L::round(radians * L::broadcast(6.36619772367581382433e-01));  // 2/π
+	L r = radians - quadrant * L::broadcast(1.57079632673412561417e+00) - quadrant
+		* L::broadcast(6.07710050650619224932e-11);
+	L r2 = r * r;
+
+	L sine_r = r + r * r2 * (L::broadcast(-1.66666666666666324348e-01) + r2 * (L::broadcast(8.33333333332248946124e-03)
+		+ r2 * (L::broadcast(-1.98412698298579493134e-04) + r2 * (L::broadcast(2.75573137070700676789e-06)
+		+ r2 * (L::broadcast(-2.50507602534068634195e-08) + r2 * L::broadcast(1.58969099521155010221e-10))))));
+	L cosine_r = L::broadcast(1.0) - L::broadcast(0.5) * r2 + r2 * r2 * (L::broadcast(4.16666666666666019037e-02)
+		+ r2 * (L::broadcast(-1.38888888888741095749e-03) + r2 * (L::broadcast(2.48015872894767294178e-05)
+		+ r2 * (L::broadcast(-2.75573143513906633035e-07) + r2 * (L::broadcast(2.08757232129817482790e-09)
+		+ r2 * L::broadcast(-1.13596475577881948265e-11))))));
+
+	// quadrant ∈ {-2, -1, 0, 1, 2}
+	typename L::Mask odd = L::equal(quadrant * quadrant, L::broadcast(1.0));
+	typename L::Mask half_turn = L::equal(quadrant * quadrant, L::broadcast(4.0));
+	L swapped_sine = L::select(odd, cosine_r, sine_r);
+	L swapped_cosine = L::select(odd, sine_r, cosine_r);
+	sine = L::select(L::either(half_turn, L::equal(quadrant, L::broadcast(-1.0))), -swapped_sine, swapped_sine);
+	cosine = L::select(L::either(half_turn, L::equal(quadrant, L::broadcast(1.0))), -swapped_cosine, swapped_cosine);
+}
+
+
+template<typename L>
+L sine_degrees(L degrees)
+{
+	L sine, cosine;
+	sincos_degrees(degrees, sine, cosine);
+	return sine;
+}
+
+
+template<typename L>
+L cosine_degrees(L degrees)
+{
+	L sine, cosine;
+	sincos_degrees(degrees, sine, cosine);
+	return cosine;
+}
+
+
+// ———————————————————————————————————————————————————— KERNELS  ———————————————————————————————————————————————————— //
+
+template<typename L>
+void sun_kernel(L terrestrial_time, L& x, L& y, L& z)
+/*
+Geolocation::sun_inertial_coordinates [solid.f LN 919–941]
+*/
+{
+	L solar_ephemerides_degrees = L::broadcast(357.5256) + L::broadcast(35999.049) * terrestrial_time;
+
+	L sin_solar_ephemerides, cos_solar_ephemerides, sin_solar_ephemerides2, cos_solar_ephemerides2;
+	sincos_degrees(solar_ephemerides_degrees, sin_solar_ephemerides, cos_solar_ephemerides);
+	sincos_degrees(solar_ephemerides_degrees * L::broadcast(2.0), sin_solar_ephemerides2, cos_solar_ephemerides2);
+
+	L radius = (L::broadcast(149.619) - L::broadcast(2.499) * cos_solar_ephemerides - L::broadcast(0.021)
+		* cos_solar_ephemerides2) * L::broadcast(1000000000);
+	L solar_longitude_degrees = (L::broadcast(6892.0) * sin_solar_ephemerides + L::broadcast(72.0)
+		* sin_solar_ephemerides2) * L::broadcast(1.0 / 3600.0) + L::broadcast(Geolocation::OPOD)
+		+ solar_ephemerides_degrees + L::broadcast(1.3972) * terrestrial_time;
+
+	L sin_solar_longitude, cos_solar_longitude;
+	sincos_degrees(solar_longitude_degrees, sin_solar_longitude, cos_solar_longitude);
+
+	x = radius * cos_solar_longitude;
+	y = radius * sin_solar_longitude * L::broadcast(Geolocation::COS_OBLIQUITY);
+	z = radius * sin_solar_longitude * L::broadcast(Geolocation::SIN_OBLIQUITY);
+}
+
+
+template<typename L>
+void moon_kernel(L terrestrial_time, L& x, L& y, L& z)
+/*
+Geolocation::moon_inertial_coordinates [solid.f LN 751–830], term for term.
+*/
+{
+	L mean_lunar_longitude = L::broadcast(218.31617) + L::broadcast(481267.88088) * terrestrial_time
+		- L::broadcast(1.3972) * terrestrial_time;
+	L mean_lunar_anomaly = L::broadcast(134.96292) + L::broadcast(477198.86753) * terrestrial_time;
+	L mean_solar_anomaly = L::broadcast(357.52543) + L::broadcast(35999.04944) * terrestrial_time;
+	L mean_lunar_angular_distance = L::broadcast(93.27283) + L::broadcast(483202.01873) * terrestrial_time;
+	L mean_lunar_and_solar_difference = L::broadcast(297.85027) + L::broadcast(445267.11135) * terrestrial_time;
+
+	L mean_lunar_and_solar_anomaly = mean_lunar_anomaly + mean_solar_anomaly;
+	L mean_lunar_distance_minus_anomaly = mean_lunar_angular_distance - mean_lunar_anomaly;
+	L two = L::broadcast(2.0);
+
+	L solar_ecliptic_longitude_degrees = mean_lunar_longitude
+		+ L::broadcast(22640.0 / 3600.0) * sine_degrees(mean_lunar_anomaly)
+		+ L::broadcast(769.0 / 3600.0) * sine_degrees(mean_lunar_anomaly * two)
+		+ L::broadcast(-4586.0 / 3600.0) * sine_degrees(mean_lunar_anomaly - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(2370.0 / 3600.0) * sine_degrees(mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-668.0 / 3600.0) * sine_degrees(mean_solar_anomaly)
+		+ L::broadcast(-412.0 / 3600.0) * sine_degrees(mean_lunar_angular_distance * two)
+		+ L::broadcast(-212.0 / 3600.0) * sine_degrees(mean_lunar_anomaly * two - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-206.0 / 3600.0) * sine_degrees(mean_lunar_and_solar_anomaly - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(192.0 / 3600.0) * sine_degrees(mean_lunar_anomaly + mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-165.0 / 3600.0) * sine_degrees(mean_solar_anomaly - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(148.0 / 3600.0) * sine_degrees(mean_lunar_anomaly - mean_solar_anomaly)
+		+ L::broadcast(-125.0 / 3600.0) * sine_degrees(mean_lunar_and_solar_difference)
+		+ L::broadcast(-110.0 / 3600.0) * sine_degrees(mean_lunar_and_solar_anomaly)
+		+ L::broadcast(-55.0 / 3600.0) * sine_degrees(mean_lunar_angular_distance * two
+			- mean_lunar_and_solar_difference * two);
+
+	L temp = L::broadcast(412.0 / 3600.0) * sine_degrees(mean_lunar_angular_distance * two)
+		+ L::broadcast(541.0 / 3600.0) * sine_degrees(mean_solar_anomaly);
+
+	L solar_ecliptic_latitude_degrees =
+		L::broadcast(18520.0 / 3600.0) * sine_degrees(mean_lunar_angular_distance + solar_ecliptic_longitude_degrees
+			- mean_lunar_longitude + temp)
+		- L::broadcast(526.0 / 3600.0) * sine_degrees(mean_lunar_angular_distance - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(44.0 / 3600.0) * sine_degrees(mean_lunar_anomaly + mean_lunar_angular_distance
+			- mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-31.0 / 3600.0) * sine_degrees(mean_lunar_distance_minus_anomaly
+			- mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-25.0 / 3600.0) * sine_degrees(-mean_lunar_anomaly + mean_lunar_distance_minus_anomaly)
+		+ L::broadcast(-23.0 / 3600.0) * sine_degrees(mean_solar_anomaly + mean_lunar_angular_distance
+			- mean_lunar_and_solar_difference * two)
+		+ L::broadcast(21.0 / 3600.0) * sine_degrees(mean_lunar_distance_minus_anomaly)
+		+ L::broadcast(11.0 / 3600.0) * sine_degrees(-mean_solar_anomaly + mean_lunar_angular_distance
+			- mean_lunar_and_solar_difference * two);
+
+	L lunar_distance = L::broadcast(385000000.0)
+		+ L::broadcast(-20905000.0) * cosine_degrees(mean_lunar_anomaly)
+		+ L::broadcast(-3699000.0) * cosine_degrees(mean_lunar_and_solar_difference * two - mean_lunar_anomaly)
+		+ L::broadcast(-2956000.0) * cosine_degrees(mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-570000.0) * cosine_degrees(mean_lunar_anomaly * two)
+		+ L::broadcast(246000.0) * cosine_degrees(mean_lunar_anomaly * two - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-205000.0) * cosine_degrees(mean_solar_anomaly - mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-171000.0) * cosine_degrees(mean_lunar_anomaly + mean_lunar_and_solar_difference * two)
+		+ L::broadcast(-152000.0) * cosine_degrees(mean_lunar_and_solar_anomaly - mean_lunar_and_solar_difference * two);
+
+	solar_ecliptic_longitude_degrees = solar_ecliptic_longitude_degrees + L::broadcast(1.3972) * terrestrial_time;
+
+	L sin_solar_ecliptic_latitude, cos_solar_ecliptic_latitude;
+	L sin_solar_ecliptic_longitude, cos_solar_ecliptic_longitude;
+	sincos_degrees(solar_ecliptic_latitude_degrees, sin_solar_ecliptic_latitude, cos_solar_ecliptic_latitude);
+	sincos_degrees(solar_ecliptic_longitude_degrees, sin_solar_ecliptic_longitude, cos_solar_ecliptic_longitude);
+
+	L ecliptic_x = lunar_distance * cos_solar_ecliptic_longitude * cos_solar_ecliptic_latitude;
+	L ecliptic_y = lunar_distance * sin_solar_ecliptic_longitude * cos_solar_ecliptic_latitude;
+	L ecliptic_z = lunar_distance * sin_solar_ecliptic_latitude;
+
+	// rot1(-oblir)
+	double obliquity_ecliptic_radians = 23.43929111 / Geolocation::RADIAN;
+	L sin_theta = L::broadcast(sin(-obliquity_ecliptic_radians));
+	L cos_theta = L::broadcast(cos(-obliquity_ecliptic_radians));
+	x = ecliptic_x;
+	y = cos_theta * ecliptic_y + sin_theta * ecliptic_z;
+	z = cos_theta * ecliptic_z - sin_theta * ecliptic_y;
+}
+
+
+template<typename L, void (*kernel)(L, L&, L&, L&)>
+void run_kernel(const double* terrestrial_time, std::size_t count, double* x, double* y, double* z)
+/*
+Full blocks are loaded straight from the caller's arrays; the remainder is padded into a full block, so that every
+ epoch takes the same path regardless of where it falls in the series.
+*/
+{
+	std::size_t index = 0;
+	for(; index + L::WIDTH <= count; index += L::WIDTH)
+	{
+		L block_x, block_y, block_z;
+		kernel(L::load(terrestrial_time + index), block_x, block_y, block_z);
+		block_x.store(x + index);
+		block_y.store(y + index);
+		block_z.store(z + index);
+	}
+
+	if(index < count)
+	{
+		double padded_time[L::WIDTH], padded_x[L::WIDTH], padded_y[L::WIDTH], padded_z[L::WIDTH];
+		for(unsigned int lane = 0; lane < L::WIDTH; lane++)
+		{
+			padded_time[lane] = terrestrial_time[index + lane < count ? index + lane : count - 1];
+		}
+
+		L block_x, block_y, block_z;
+		kernel(L::load(padded_time), block_x, block_y, block_z);
+		block_x.store(padded_x);
+		block_y.store(padded_y);
+		block_z.store(padded_z);
+		for(unsigned int lane = 0; index + lane < count; lane++)
+		{
+			x[index + lane] = padded_x[lane];
+			y[index + lane] = padded_y[lane];
+			z[index + lane] = padded_z[lane];
+		}
+	}
+}
@@ -0,0 +1,52 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+
+
+class EphemerisKernels
+/*
+Evaluates `Geolocation::sun_inertial_coordinates` & `Geolocation::moon_inertial_coordinates` for many epochs at once,
+ `lanes()` epochs per instruction stream. The widest of AVX-512 (8 lanes) & AVX2 (4 lanes) that the processor supports
+ is picked at the first call, so that a build for baseline x86-64 still uses them; otherwise the same series run one
+ lane at a time (EphemerisKernelSeries.hpp).
+The series are unchanged, but `sin`/`cos` are replaced by a vectorized sincos (fdlibm kernel polynomials) on arguments
+ reduced modulo 360° before the conversion to radians. The `*_deviation` functions report the largest difference [m]
+ against the scalar series over the given epochs.
+*/
+{
+	public:
+		static unsigned int lanes();
+		static const char* instruction_set();
+
+		static void sun_inertial_coordinates(const double* terrestrial_time, std::size_t count, double* x, double* y,
+			double* z
+		);
+		static void moon_inertial_coordinates(const double* terrestrial_time, std::size_t count, double* x, double* y,
+			double* z
+		);
+
+		static double sun_deviation(const double* terrestrial_time, std::size_t count);
+		static double moon_deviation(const double* terrestrial_time, std::size_t count);
+
+	private:
+		typedef void (*Kernel)(const double* terrestrial_time, std::size_t count, double* x, double* y, double* z);
+
+		struct Implementation
+		{
+			const char* instruction_set;
+			unsigned int lanes;
+			Kernel sun;
+			Kernel moon;
+		};
+
+		static const Implementation SCALAR;
+#if defined(__x86_64__) || defined(__i386__)
+		static const Implementation AVX2;  // EphemerisKernelsAVX2.cpp
+		static const Implementation AVX512;  // EphemerisKernelsAVX512.cpp
+#endif
+
+		static const Implementation& implementation();
+};
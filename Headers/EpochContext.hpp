@@ -0,0 +1,55 @@
+
+
+#pragma once
+
+
+#include "FundamentalArguments.hpp"
+
+
+class JulianDate;
+
+
+class EpochContext
+/*
+Everything about one UTC epoch that the ephemerides & the corrections need: the UTC, TAI & TT times, the julian
+ centuries, the hours in the TT day, the Greenwich hour angle (with its sine & cosine) & the `FundamentalArguments`.
+ solid.f re-derives these in `sunxyz`, `moonxyz` & `detide` (each calling `utc2ttt` & `getghar`); here they are built
+ once per epoch and shared by every station.
+`leap_second_flag` replaces solid.f's `leapflag` common block: it is raised when the epoch is outside the leap second
+ table (`LeapSecondTable::contains()`).
+*/
+{
+	public:
+		struct Step
+		{
+			double greenwich_hour_angle;  // radians
+			double sin_greenwich_hour_angle;
+			double cos_greenwich_hour_angle;
+			FundamentalArguments::Step fundamental_arguments;
+		};
+
+		static const double PROBE_DAYS;  // 0.4: the span `step()` measures the angles' rates over
+
+		EpochContext(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		EpochContext(JulianDate& julian_date, const EpochContext& previous, const Step& step);
+
+		static Step step(const EpochContext& from, double step_seconds);
+
+		const unsigned int modified_julian_date;  // mjd (UTC)
+		const double fractional_modified_julian_date;  // fmjd (UTC)
+		const double time_seconds_UTC;  // tsecutc: seconds of the UTC day
+		const double time_seconds_TAI;  // ttai: relative to the start of the UTC day
+		const double terrestrial_time_days;  // dmjdtt: MJD in TT
+		const bool leap_second_flag;  // lflag: true means the flag *IS* raised
+
+		const FundamentalArguments fundamental_arguments;
+		const double julian_centuries;  // t (sunxyz, moonxyz): julian centuries (TT) from J2000.0
+		const double terrestrial_time_hours;  // fhr: hours in the TT day
+
+		const double greenwich_hour_angle;  // ghar: radians
+		const double sin_greenwich_hour_angle;
+		const double cos_greenwich_hour_angle;
+
+	private:
+		static double advance(double greenwich_hour_angle, double step);
+};
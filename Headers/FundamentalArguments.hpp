@@ -0,0 +1,73 @@
+
+
+#pragma once
+
+
+class FundamentalArguments
+/*
+The Doodson/Delaunay arguments of one TT epoch. `step2diu`, `step2lon` & `moonxyz` each evaluate their own copy of these
+ polynomials; they are evaluated once here (in Horner form) together with the sine & cosine of every argument, and the
+ value is passed to each of them.
+The step 2 arguments use solid.f's `t` (julian centuries from MJD 51544.0) & are reduced to (-360°, 360°) as solid.f
+ does; the lunar arguments use `moonxyz`'s `t` (julian centuries from J2000.0, MJD 51544.5).
+Over a short span every argument is linear in time, so a later epoch can also be advanced from an earlier one by a
+ `Step` (the change of each argument, as an angle with its sine & cosine) instead of evaluating the polynomials & their
+ sines & cosines again.
+*/
+{
+	public:
+		struct Argument
+		{
+			double degrees;
+			double sine;
+			double cosine;
+		};
+
+		struct Step
+		{
+			Argument s, tau, h, p, zns, ps;
+			double el0;  // degrees
+			Argument el, elp, f, d;
+		};
+
+		FundamentalArguments(double terrestrial_time_days);
+		FundamentalArguments(double terrestrial_time_days, const FundamentalArguments& previous, const Step& step);
+
+		static Step step(const FundamentalArguments& from, const FundamentalArguments& to, double fraction);
+
+		const double terrestrial_time_days;  // dmjdtt: MJD in TT
+		const double terrestrial_time_years;  // t (detide): julian centuries from MJD 51544.0
+		const double terrestrial_time_hours;  // fhr: hours in the TT day
+		const double julian_centuries;  // t (moonxyz, sunxyz): julian centuries from J2000.0
+
+		// step2diu & step2lon [solid.f LN 449–472]
+		const double pr;  // general precession in longitude, already included in s
+		const Argument s;
+		const Argument tau;
+		const Argument h;
+		const Argument p;
+		const Argument zns;  // N'
+		const Argument ps;
+		/*
+		Cosine & sine of m·s, m·h, m·p, m·N' & m·ps for m in [-MULTIPLE, MULTIPLE] (index m + MULTIPLE), the integer
+		 multiples that the step 2 tables combine.
+		*/
+		static const int MULTIPLE = 3;
+		double multiple_cosine[5][2 * MULTIPLE + 1];
+		double multiple_sine[5][2 * MULTIPLE + 1];
+
+		// moonxyz [solid.f LN 758–762]
+		const double el0;  // mean_lunar_longitude
+		const Argument el;  // mean_lunar_anomaly
+		const Argument elp;  // mean_solar_anomaly
+		const Argument f;  // mean_lunar_angular_distance
+		const Argument d;  // mean_lunar_and_solar_difference
+
+	private:
+		void multiples();
+
+		static Argument argument(double degrees);
+		static Argument advance(const Argument& argument, const Argument& step);
+		static Argument difference(const Argument& from, const Argument& to, double fraction);
+		static double s_less_pr(double terrestrial_time_years);
+};
@@ -1,10 +1,24 @@
 
 
+#pragma once
+
+
+#include <cstddef>
+#include <memory>
+
+
 #include "Coordinate.hpp"
 
 
+class ChebyshevEphemeris;
 class Datetime;
+class EphemerisCache;
+class EpochContext;
+class FundamentalArguments;
 class JulianDate;
+class StationFrame;
+class ThreadPool;
+class UniformEpochs;
 
 
 class Geolocation
@@ -83,33 +97,113 @@ class Geolocation
 		static const double LUNAR_MASS_RATIO;  // 0.012300034: mass_ratio_moon=0.012300034d0
 		static const double RE;  // 6378136.55: re=6378136.55d0
 
-		Geolocation(double latitude_degrees, double longitude_degrees);
+		// Samples per ephemeris kernel call in `tide_series`: a multiple of `UniformEpochs::MAX_ANCHOR_INTERVAL`
+		static const std::size_t SERIES_BLOCK = 256;
+
+		/*
+		How `moon_inertial_coordinates` evaluates the sines & cosines of its 31 periodic terms: DIRECT calls `sin`/`cos`
+		 for every term (as solid.f does); ANGLE_ADDITION takes sin/cos of el, elp, f & d once and builds each term's
+		 integer combination by complex multiplication.
+		*/
+		enum class LunarSeries
+		{
+			DIRECT,
+			ANGLE_ADDITION
+		};
+
+		Geolocation(double latitude_degrees, double longitude_degrees, double height_meters=0.0);
 		operator Coordinate<double>();
 
-		Coordinate<double> sun_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
-		Coordinate<double> moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		static double east_longitude(double longitude_degrees);
+
+		static Coordinate<double> sun_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		static Coordinate<double> sun_coordinates(const EpochContext& epoch_context);
+		static Coordinate<double> moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		static Coordinate<double> moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+			LunarSeries lunar_series
+		);
+		static Coordinate<double> moon_coordinates(const EpochContext& epoch_context, LunarSeries lunar_series);
+		static Coordinate<double> sun_inertial_coordinates(double terrestrial_time);
+		static Coordinate<double> moon_inertial_coordinates(double terrestrial_time);
+		static Coordinate<double> moon_inertial_coordinates(double terrestrial_time, LunarSeries lunar_series);
+		static Coordinate<double> moon_inertial_coordinates(const FundamentalArguments& fundamental_arguments);
 		Coordinate<double> tide(unsigned int initial_modified_julian_date, JulianDate& julian_date);
+		Coordinate<double> tide(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+			EphemerisCache& ephemeris_cache
+		);
+		Coordinate<double> tide(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+			const StationFrame& station_frame, Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate
+		);
+		Coordinate<double> tide(const EpochContext& epoch_context, LunarSeries lunar_series=LunarSeries::DIRECT);
+		Coordinate<double> tide(const EpochContext& epoch_context, const StationFrame& station_frame,
+			Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate
+		);
+		void tide_series(unsigned int modified_julian_date, double fractional_modified_julian_date, double step_seconds,
+			std::size_t count, double* x, double* y, double* z
+		);
+		void tide_series(unsigned int modified_julian_date, double fractional_modified_julian_date, double step_seconds,
+			std::size_t count, double* x, double* y, double* z, ThreadPool& thread_pool
+		);
+		void tide_series(const UniformEpochs& uniform_epochs, const ChebyshevEphemeris* chebyshev_ephemeris,
+			std::size_t first, std::size_t count, double* x, double* y, double* z, ThreadPool& thread_pool
+		);
+		static std::unique_ptr<ChebyshevEphemeris> series_ephemeris(const UniformEpochs& uniform_epochs,
+			std::size_t count
+		);
+		static void series_coordinates(const EpochContext* epoch_contexts, std::size_t count,
+			const ChebyshevEphemeris* chebyshev_ephemeris, Coordinate<double>* solar_coordinates,
+			Coordinate<double>* lunar_coordinates
+		);
+		void local_horizon(std::size_t count, const double* x, const double* y, const double* z, double* north,
+			double* east, double* up
+		);
 
-		Coordinate<double> mantle_inelasticity_1st_diurnal_band_correction(Coordinate<double>& geo_coordinate, 
+		Coordinate<double> mantle_inelasticity_1st_diurnal_band_correction(const StationFrame& station_frame,
 			Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-			double lunar_factor2 
+			double lunar_factor2
 		);
-		Coordinate<double> mantle_inelasticity_semi_diurnal_band_correction(Coordinate<double>& geo_coordinate, 
+		Coordinate<double> mantle_inelasticity_semi_diurnal_band_correction(const StationFrame& station_frame,
 			Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-			double lunar_factor2 
+			double lunar_factor2
 		);
-		Coordinate<double> latitude_dependence_correction(Coordinate<double>& geo_coordinate, 
+		Coordinate<double> latitude_dependence_correction(const StationFrame& station_frame,
 			Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-			double lunar_factor2 
+			double lunar_factor2
 		);
-		Coordinate<double> second_step_diurnal_band_correction(Coordinate<double>& geo_coordinate,
-			double terrestrial_time_hours, double terrestrial_time_years
+		Coordinate<double> second_step_diurnal_band_correction(const StationFrame& station_frame,
+			const EpochContext& epoch_context
 		);
-		Coordinate<double> second_step_longitudinal_correction(Coordinate<double>& geo_coordinate,
-			double terrestrial_time_hours, double terrestrial_time_years
+		Coordinate<double> second_step_longitudinal_correction(const StationFrame& station_frame,
+			const EpochContext& epoch_context
 		);
 
 	private:
+		/*
+		Samples per fitted day from which `tide_series` evaluates the sun & moon by a `ChebyshevEphemeris` rather than
+		 the `EphemerisKernels`. A fitted day costs about 110 kernel evaluations (its checks are the direct series) & a
+		 fitted epoch about half the AVX-512 kernels' time, so this repays the fit with every instruction set.
+		*/
+		static const std::size_t CHEBYSHEV_SAMPLES_PER_DAY;  // 288
+
+		void tide_series_blocks(const StationFrame& station_frame, const UniformEpochs& uniform_epochs,
+			const ChebyshevEphemeris* chebyshev_ephemeris, std::size_t first, std::size_t count, double* x, double* y,
+			double* z
+		);
+
+		/*
+		solid.f [LN 388–447...521–526] datdi of step2diu & step2lon, stored by column so that each argument's
+		 multipliers (s, h, p, N', ps) & each amplitude [mm] are contiguous across the rows. The multipliers are
+		 integers; the amplitudes are dR(ip), dR(op), dT(ip), dT(op) for the diurnal band & dR(ip), dT(ip), dR(op),
+		 dT(op) for the long-period band, as in solid.f.
+		*/
+		static const unsigned int DIURNAL_BAND_ROWS = 31;
+		static const unsigned int LONG_PERIOD_BAND_ROWS = 5;
+		static const int DIURNAL_BAND_MULTIPLIERS[5][DIURNAL_BAND_ROWS];
+		static const double DIURNAL_BAND_AMPLITUDES[4][DIURNAL_BAND_ROWS];
+		static const int LONG_PERIOD_BAND_MULTIPLIERS[5][LONG_PERIOD_BAND_ROWS];
+		static const double LONG_PERIOD_BAND_AMPLITUDES[4][LONG_PERIOD_BAND_ROWS];
+
 		const double _latitude;  // Radians
 		const double _longitude;  // Radians
+		const double _height;  // Meters above the ellipsoid
 };
@@ -0,0 +1,108 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
+
+#include "Geolocation.hpp"
+#include "StationFrame.hpp"
+
+
+class ThreadPool;
+
+
+class JobPlanner
+/*
+Merges many series requests (station, start, step, count) into as few series as cover them, evaluates those in chunks
+ & hands each chunk to every request that asked for it, so that memory is bounded by the chunk rather than the job.
+Requests at one station on one grid of epochs (the same step, with starts a whole number of steps apart) whose ranges
+ overlap or touch become one run, evaluated once; a request whose step is a whole multiple of a run's & whose epochs all
+ lie on it (e.g. a 60 s series within a 30 s one) reads every n-th sample of that run. Runs of different stations over
+ the same epochs form a group of up to `GROUP_STATIONS`, whose `EpochContext`s, sun & moon are evaluated once for all
+ its stations; a group of one station is a plain `Geolocation::tide_series`.
+Epochs are matched on their UTC time rounded to `EPOCH_RESOLUTION_SECONDS`, steps exactly. Every group is evaluated as
+ `tide_series` evaluates the series of its first run, so the results depend neither on the number of threads nor on
+ the chunks, and a station's run is identical whether or not other stations share its group.
+*/
+{
+	public:
+		/*
+		Hands samples [`first`, `first` + `count`) of `request` (ECEF, meters) to the caller; the arrays are only valid
+		 during the call. A request's samples arrive in order, all of them before those of the next group's requests.
+		*/
+		typedef std::function<void(std::size_t request, std::size_t first, std::size_t count, const double* x,
+			const double* y, const double* z)> Output;
+
+		static const double EPOCH_RESOLUTION_SECONDS;  // 1 µs
+		static const std::size_t CHUNK_VALUES;  // 1 << 20 station epochs per chunk, 24 MiB of results
+		static const std::size_t GROUP_STATIONS;  // 64
+
+		JobPlanner();
+
+		std::size_t station(double latitude_degrees, double longitude_degrees, double height_meters);
+		std::size_t request(std::size_t station, unsigned int modified_julian_date, double start_seconds,
+			double step_seconds, std::size_t count
+		);
+
+		std::size_t stations() const;  // Distinct
+		std::size_t runs() const;  // Known after `run()`
+		std::size_t epochs() const;  // Distinct, over all groups; known after `run()`
+		std::size_t evaluations() const;  // Over all runs; known after `run()`
+		std::size_t samples() const;  // Over all requests
+
+		void run(ThreadPool& thread_pool, const Output& output);
+
+	private:
+		struct Request
+		{
+			std::size_t station;
+			unsigned int modified_julian_date;
+			double start_seconds;  // From the start of `modified_julian_date`
+			double step_seconds;
+			std::size_t count;
+		};
+
+		struct Run
+		/*
+		A series that one or more requests read: sample `offset` + index × `stride` of the run is sample `index` of
+		 such a request.
+		*/
+		{
+			std::size_t station;
+			std::size_t request;  // Whose start & step the run's epochs are
+			std::int64_t start_key;  // Epoch keys, see `epoch_key()`
+			std::int64_t step_key;
+			std::size_t count;
+			std::vector<std::size_t> requests;
+			std::vector<std::size_t> offsets;
+			std::vector<std::size_t> strides;
+		};
+
+		typedef std::tuple<double, double, double> Coordinates;  // Latitude, longitude, height
+
+		std::int64_t epoch_key(unsigned int modified_julian_date, double seconds) const;
+		void plan();
+		void evaluate(const std::vector<std::size_t>& group, ThreadPool& thread_pool, const Output& output);
+		void deliver(const Run& run, std::size_t first, std::size_t count, const double* x, const double* y,
+			const double* z, const Output& output
+		);
+
+		std::vector<double> _latitudes;  // Degrees, by station
+		std::vector<double> _longitudes;
+		std::vector<double> _heights;
+		std::map<Coordinates, std::size_t> _station_indices;
+		std::vector<Geolocation> _geolocations;
+		std::vector<StationFrame> _station_frames;
+		std::vector<Request> _requests;
+		unsigned int _first_modified_julian_date;
+
+		std::vector<Run> _runs;
+		std::vector<std::vector<std::size_t>> _groups;  // Runs over the same epochs, by first epoch
+};
@@ -0,0 +1,39 @@
+
+
+#pragma once
+
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+class LeapSecondTable
+/*
+TAI−UTC [s] by UTC day, as the MJDs on which each value takes effect. `getutcmtai` in solid.f hard codes these as a
+ chain of `if`s; here they are a sorted table searched by bisection, which can be replaced at startup by an IERS
+ `Leap_Second.dat` file.
+The table is valid from its first entry through `last_modified_julian_date()` (the file's expiry date, when it states
+ one). Outside that range the nearest value is used & `contains()` is false (solid.f's `leapflag`).
+A table is immutable once built; `load()` publishes a new current one atomically, so it is safe during evaluations.
+*/
+{
+	public:
+		LeapSecondTable();
+		LeapSecondTable(const std::string& path);
+
+		static const LeapSecondTable& current();
+		static void load(const std::string& path);
+
+		bool contains(int modified_julian_date) const;
+		double TAI_minus_UTC(int modified_julian_date) const;
+		int first_modified_julian_date() const;
+		int last_modified_julian_date() const;
+
+	private:
+		static std::atomic<const LeapSecondTable*>& current_table();
+
+		std::vector<int> _modified_julian_dates;  // Day each value takes effect (ascending)
+		std::vector<double> _TAI_minus_UTC;
+		int _last_modified_julian_date;
+};
@@ -0,0 +1,89 @@
+
+
+#pragma once
+
+
+/*
+C interface of libsolidearthtide (`make library`), for engines that embed the tide in their own processing. Only these
+ functions are exported from the shared library; the C++ classes behind them may change, these may not. Callers own
+ every buffer. Linking the static library from C also needs the C++ runtime (`-lstdc++ -lm -pthread`).
+*/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#define SOLID_EARTH_TIDE_ABI_VERSION 1
+
+#if defined(__GNUC__)
+	#define SOLID_EARTH_TIDE_API __attribute__((visibility("default")))
+#else
+	#define SOLID_EARTH_TIDE_API
+#endif
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+enum solid_earth_tide_status
+{
+	SOLID_EARTH_TIDE_OK = 0,
+	SOLID_EARTH_TIDE_INVALID_ARGUMENT = 1,  // A null buffer, or a station, epoch or frame out of range
+	SOLID_EARTH_TIDE_FILE_ERROR = 2,  // Leap second file missing or malformed
+	SOLID_EARTH_TIDE_INTERNAL_ERROR = 3
+};
+
+
+enum solid_earth_tide_frame
+{
+	SOLID_EARTH_TIDE_ECEF = 0,  // X, Y, Z
+	SOLID_EARTH_TIDE_ENU = 1  // East, north, up (as `TideSeriesFile::Frame::ENU`)
+};
+
+
+/*
+`SOLID_EARTH_TIDE_ABI_VERSION` of the library actually loaded.
+*/
+SOLID_EARTH_TIDE_API int solid_earth_tide_abi_version(void);
+
+
+/*
+A short description of `status`, valid for the life of the process.
+*/
+SOLID_EARTH_TIDE_API const char* solid_earth_tide_status_message(int status);
+
+
+/*
+Replaces the built-in leap second table with an IERS `Leap_Second.dat`. May be called while other threads evaluate:
+ the new table is published atomically, & each epoch converts with the old table or the new one.
+The built-in table expires on 2026-06-28 (IERS Bulletin C 70): every later epoch raises its leap second flag until a
+ current `Leap_Second.dat` (https://hpiers.obspm.fr/iers/bul/bulc/Leap_Second.dat) is loaded with this.
+*/
+SOLID_EARTH_TIDE_API int solid_earth_tide_load_leap_seconds(const char* path);
+
+
+/*
+solid.f's `detide` (& `rge` for `SOLID_EARTH_TIDE_ENU`) for every station at every epoch.
+Stations are geodetic latitudes [-90, +90] & longitudes [-360, +360] in degrees, & ellipsoidal heights in meters;
+ `heights` may be null for 0 m. Epochs are UTC modified Julian dates (1901–2099) & fractions of a day [0, 1).
+The displacement of station `s` at epoch `e` is written to `x`, `y` & `z` [m] at index `s * epoch_count + e`; each must
+ hold `station_count * epoch_count` values. `leap_second_flags`, if not null, gets solid.f's `lflag` per epoch.
+`threads` 0 uses one per hardware thread; the work is split over blocks of epochs & of stations, so one epoch at many
+ stations is spread over them too. The threads are one pool shared by the process: a call made while another call is
+ using it is evaluated on its own calling thread instead of waiting, so callers on several threads of their own run
+ concurrently. Nothing is written unless every argument is valid.
+*/
+SOLID_EARTH_TIDE_API int solid_earth_tide_evaluate(const double* latitudes_degrees, const double* longitudes_degrees,
+	const double* heights_meters, size_t station_count, const int32_t* modified_julian_dates,
+	const double* fractional_modified_julian_dates, size_t epoch_count, int frame, unsigned int threads, double* x,
+	double* y, double* z, uint8_t* leap_second_flags
+);
+
+
+#ifdef __cplusplus
+}
+#endif
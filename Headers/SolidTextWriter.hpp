@@ -0,0 +1,55 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+class SolidTextWriter
+/*
+Writes tide series in solid.f's `solid.txt` layout, byte for byte as gfortran formats it: the two header lines, then one
+ `(f8.1,3f10.6)` line of seconds of the day & north, east, up [m] per sample.
+Lines are formatted directly into one `BUFFER_BYTES` buffer, which is written out with `write(2)` when full, so nothing
+ is allocated per line. Numbers are rounded as gfortran does (to nearest, ties to even, on the exact binary value);
+ fields that do not fit are filled with `*`.
+*/
+{
+	public:
+		static const std::size_t BUFFER_BYTES;  // 1 MiB
+
+		SolidTextWriter(const std::string& path);
+		SolidTextWriter(int file_descriptor);  // Not closed by the writer, e.g. 1 for standard output
+		SolidTextWriter(const SolidTextWriter&) = delete;
+		SolidTextWriter& operator=(const SolidTextWriter&) = delete;
+		~SolidTextWriter();
+
+		void header(int year, int month, int day, double latitude_degrees, double longitude_degrees);
+		void line(double time_seconds, double north, double east, double up);
+		void series(double start_seconds, double step_seconds, std::size_t count, const double* north,
+			const double* east, const double* up
+		);
+		void daily_series(unsigned int modified_julian_date, double start_seconds, double step_seconds, std::size_t count,
+			const double* north, const double* east, const double* up, double latitude_degrees, double longitude_degrees
+		);
+		void flush();
+
+	private:
+		void text(const char* characters, std::size_t length);
+		void tenths(long long value);  // f8.1 of `value` / 10
+		void fixed(double value, unsigned int width, unsigned int decimals);
+		void integer(long long value, unsigned int width);
+		void field(bool negative, unsigned long long whole, unsigned long long fraction, unsigned int width,
+			unsigned int decimals
+		);
+		void asterisks(unsigned int width);
+
+		const int _file_descriptor;
+		const bool _owned;
+		std::vector<char> _buffer;
+		std::size_t _used;
+		bool _has_day;  // Whether `daily_series()` has written a day's header
+		unsigned int _day;  // MJD of that header
+};
@@ -0,0 +1,164 @@
+
+
+#pragma once
+
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+
+/*
+The stage timers of `Geolocation::tide()` & the batch paths that feed it. Without `SOLID_EARTH_TIDE_INSTRUMENT`
+ (`make INSTRUMENT=1`) these expand to nothing, so that a normal build carries no timer code at all.
+`SOLID_EARTH_TIDE_STAGE(timer, STAGE)` starts a timer named `timer` on `StageTimer::Stage::STAGE` that stops at the end
+ of the scope, `..._STAGE_COUNT` counts it as `count` calls (a block of epochs), `..._STAGE_NEXT` stops it & starts it
+ on the next stage (for as many calls) with one clock read, and `..._STAGE_STOP` stops it early.
+*/
+#ifdef SOLID_EARTH_TIDE_INSTRUMENT
+	#define SOLID_EARTH_TIDE_STAGE(timer, stage) StageTimer timer(StageTimer::Stage::stage)
+	#define SOLID_EARTH_TIDE_STAGE_COUNT(timer, stage, count) StageTimer timer(StageTimer::Stage::stage, count)
+	#define SOLID_EARTH_TIDE_STAGE_NEXT(timer, stage) timer.next(StageTimer::Stage::stage)
+	#define SOLID_EARTH_TIDE_STAGE_STOP(timer) timer.stop()
+#else
+	#define SOLID_EARTH_TIDE_STAGE(timer, stage)
+	#define SOLID_EARTH_TIDE_STAGE_COUNT(timer, stage, count)
+	#define SOLID_EARTH_TIDE_STAGE_NEXT(timer, stage)
+	#define SOLID_EARTH_TIDE_STAGE_STOP(timer)
+#endif
+
+
+class StageTimer
+/*
+A scoped timer of one stage of the tide. Only 1 in `sampling_interval()` timers of a stage (counted per thread) reads
+ the clock; it adds its cycles & calls, scaled by the interval, to process wide totals, so that the others cost a
+ decrement & a branch and no shared cache line is written on every call. The interval is read from the
+ `SOLID_EARTH_TIDE_SAMPLING` environment variable (default 16, 1 times every call).
+Cycles are time stamp counter cycles on x86 (nanoseconds elsewhere, see `UNIT`). A sampled timer's own clock reads are
+ counted in the stage that encloses it, so `report()` shows them in the part of `tide()` outside the other stages.
+ Instrumented builds write `report()` to standard error at exit.
+*/
+{
+	public:
+		enum class Stage
+		{
+			EVALUATION,  // The whole of `tide(epoch_context, station_frame, ...)`
+			TIME_SCALES,  // `EpochContext`s: UTC → TAI → TT, Greenwich hour angle, fundamental arguments
+			SUN,
+			MOON,
+			DEGREE_2_3,  // detide's degree 2 & 3 terms
+			STEP1_DIURNAL,  // st1idiu
+			STEP1_SEMI_DIURNAL,  // st1isem
+			STEP1_LATITUDE_DEPENDENCE,  // st1l1
+			STEP2_DIURNAL,  // step2diu
+			STEP2_LONG_PERIOD,  // step2lon
+			COUNT
+		};
+
+		static const std::size_t STAGES = static_cast<std::size_t>(Stage::COUNT);
+		static const char* const NAMES[STAGES];
+		static const char* const UNIT;
+		static const unsigned int SAMPLING_INTERVAL;  // 16
+
+		StageTimer(Stage stage, std::size_t calls=1);
+		StageTimer(const StageTimer&) = delete;
+		StageTimer& operator=(const StageTimer&) = delete;
+		~StageTimer();
+
+		void next(Stage stage);
+		void stop();
+
+		static unsigned int sampling_interval();
+		static void sampling_interval(unsigned int interval);
+		static unsigned long long calls(Stage stage);
+		static void reset();
+		static std::string report();
+
+	private:
+		static unsigned long long clock();
+		static unsigned int sample(Stage stage);
+		static void add(Stage stage, unsigned long long calls, unsigned long long cycles);
+
+		Stage _stage;
+		std::size_t _calls;
+		unsigned int _weight;  // The sampling interval when this timer is sampled, otherwise 0
+		unsigned long long _start;
+
+		static std::atomic<unsigned int> _sampling_interval;
+		static std::atomic<unsigned long long> _total_calls[STAGES];
+		static std::atomic<unsigned long long> _total_cycles[STAGES];
+};
+
+
+// The members on every instrumented call are inline, so that an unsampled timer is a few instructions
+
+inline StageTimer::StageTimer(Stage stage, std::size_t calls/*=1*/)
+: _stage{stage}, _calls{calls}, _weight{sample(stage)}, _start{_weight ? clock() : 0}
+{}
+
+
+inline StageTimer::~StageTimer()
+{
+	stop();
+}
+
+
+inline void StageTimer::next(Stage stage)
+/*
+Stops this stage & starts `stage` for as many calls, sampled when this one was, so that a chain of stages is timed
+ together.
+*/
+{
+	if(_weight)
+	{
+		unsigned long long now = clock();
+		add(_stage, static_cast<unsigned long long>(_calls) * _weight, (now - _start) * _weight);
+		_start = now;
+	}
+	_stage = stage;
+}
+
+
+inline void StageTimer::stop()
+{
+	if(_weight)
+	{
+		add(_stage, static_cast<unsigned long long>(_calls) * _weight, (clock() - _start) * _weight);
+		_weight = 0;
+	}
+}
+
+
+inline unsigned long long StageTimer::clock()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+#endif
+}
+
+
+inline unsigned int StageTimer::sample(Stage stage)
+/*
+The sampling interval for 1 in that many calls of `stage` on this thread, otherwise 0.
+*/
+{
+	static thread_local unsigned int countdown[STAGES] = {};
+	unsigned int& remaining = countdown[static_cast<std::size_t>(stage)];
+	if(remaining)
+	{
+		remaining--;
+		return 0;
+	}
+	unsigned int interval = _sampling_interval.load(std::memory_order_relaxed);
+	remaining = interval ? interval - 1 : 0;  // 0 before the interval's static initialization
+	return interval;
+}
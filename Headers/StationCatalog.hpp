@@ -0,0 +1,79 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class Geolocation;
+
+
+class StationCatalog
+/*
+A catalog of stations as contiguous arrays of latitudes & longitudes [degrees, north & east] & heights [m above the
+ ellipsoid], loaded from a memory mapped file in one of two forms:
+- CSV: one `latitude,longitude[,height[,name]]` per line. Blank lines, `#` comments & a header line (one that does not
+   start with a number) are skipped. The numbers are parsed in place from the map, without copying lines; names stay in
+   the map until `name()` asks for one.
+- Binary: a 64 byte `Header`, then the latitudes, longitudes & heights as float64 arrays each starting on a 64 byte
+   boundary (written by `write()`). The arrays are used where they are in the map, without copying.
+The map lives as long as the catalog, so the arrays (& names) are valid until it is destroyed.
+*/
+{
+	public:
+		static const char MAGIC[8];  // "SESTAT\0\1"
+		static const std::uint32_t VERSION;
+		static const std::uint32_t BYTE_ORDER_MARK;  // 0x01020304
+
+		struct Header
+		{
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t header_bytes;
+			std::uint32_t reserved;
+			std::uint64_t count;
+			std::uint64_t component_offset[3];  // Latitudes, longitudes, heights: bytes from the start of the file
+			std::uint8_t padding[8];
+		};
+
+		StationCatalog(const std::string& path);
+		StationCatalog(const StationCatalog&) = delete;
+		StationCatalog& operator=(const StationCatalog&) = delete;
+		~StationCatalog();
+
+		static void write(const std::string& path, std::size_t count, const double* latitudes_degrees,
+			const double* longitudes_degrees, const double* heights_meters
+		);
+
+		std::size_t size() const;
+		const double* latitudes() const;  // Degrees
+		const double* longitudes() const;  // Degrees
+		const double* heights() const;  // Meters
+		std::string name(std::size_t index) const;  // Empty when the catalog has none
+		std::vector<Geolocation> geolocations() const;
+
+	private:
+		static const std::size_t ALIGNMENT = 64;
+
+		void map_binary(const std::string& path);
+		void parse_csv(const std::string& path);
+		static const char* number(const char* begin, const char* end, double& value);
+		static const char* invalid(double latitude_degrees, double longitude_degrees, double height_meters);
+
+		void* _map;
+		std::size_t _map_bytes;
+		std::size_t _size;
+		const double* _latitudes;
+		const double* _longitudes;
+		const double* _heights;
+
+		// CSV only: the parsed numbers, & each name's place in the map
+		std::vector<double> _parsed[3];
+		std::vector<std::uint64_t> _name_offsets;
+		std::vector<std::uint32_t> _name_lengths;
+};
@@ -0,0 +1,49 @@
+
+
+#pragma once
+
+
+#include "Coordinate.hpp"
+
+
+class Geolocation;
+
+
+class StationFrame
+/*
+Everything about a station that does not change with the epoch. Each of `st1idiu`, `st1isem`, `st1l1`, `step2diu` &
+ `step2lon` starts by rederiving these from `xsta`; they are derived once here & shared by the corrections instead.
+ϕ is the geocentric latitude & λ the longitude, both as the Fortran derives them from `xsta`.
+*/
+{
+	public:
+		StationFrame(Geolocation& station);
+
+		const Coordinate<double> geo_coordinate;  // xsta: ECEF [m]
+		const double distance;  // rsta
+
+		const double sin_ϕ;  // sinphi
+		const double cos_ϕ;  // cosphi
+		const double sin_squared_ϕ;  // sinphi**2
+		const double cos_squared_ϕ;  // cosphi**2
+		const double sin_2ϕ;  // 2.d0*sinphi*cosphi
+		const double cos_2ϕ;  // cos2phi: cosphi**2-sinphi**2
+
+		const double λ;  // zla: datan2(xsta(2),xsta(1))
+		const double sin_λ;  // sinla
+		const double cos_λ;  // cosla
+		const double sin_2λ;  // sintwola: 2.d0*cosla*sinla
+		const double cos_2λ;  // costwola: cosla**2-sinla**2
+
+		// Latitude dependent love & shida numbers (detide h2, l2)
+		const double second_degree_love;
+		const double second_degree_shida;
+
+		// Local basis, such that xcorsta = dr * up + de * east + dn * north
+		const Coordinate<double> up;
+		const Coordinate<double> east;
+		const Coordinate<double> north;
+
+	private:
+		StationFrame(const Coordinate<double>& geo_coordinate);
+};
@@ -0,0 +1,39 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+#include "Geolocation.hpp"
+#include "StationFrame.hpp"
+
+
+class JulianDate;
+
+
+class StationSet
+/*
+A network of stations evaluated together at one epoch. The sun & moon positions do not depend on the station, so they
+ are computed once per epoch and shared by the detide step for every station in the set.
+*/
+{
+	public:
+		StationSet();
+		StationSet(std::vector<Geolocation>& stations);
+
+		void add(Geolocation station);
+		std::size_t size();
+		Geolocation& operator[](std::size_t index);
+
+		void tide(unsigned int initial_modified_julian_date, JulianDate& julian_date, double* x, double* y, double* z,
+			Geolocation::LunarSeries lunar_series=Geolocation::LunarSeries::DIRECT
+		);
+
+	private:
+		std::vector<Geolocation> _stations;
+		std::vector<StationFrame> _station_frames;  // Derived once per station when it is added
+};
@@ -0,0 +1,58 @@
+
+
+#pragma once
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class ThreadPool
+/*
+A fixed set of worker threads that persists across `run()` calls, so that a series (or a server) pays for thread
+ creation once. `run()` splits task indices [0, `tasks`) into one contiguous range per participant (the workers & the
+ calling thread); each takes from the front of its own range and, once it is empty, steals from the back of another's.
+ Tasks that take longer in one part of the range are therefore balanced without a shared queue.
+Which thread runs a task is not deterministic; callers that need deterministic output must make each task's result
+ depend only on its index. One `run()` at a time; an exception thrown by a task is rethrown by `run()` once every task
+ has finished.
+*/
+{
+	public:
+		ThreadPool(unsigned int threads=0);  // 0: one per hardware thread
+		~ThreadPool();
+
+		unsigned int size();  // Participants in `run()`, including the calling thread
+		void run(std::size_t tasks, const std::function<void(std::size_t)>& task);
+
+	private:
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<std::size_t> tasks;
+		};
+
+		void work(unsigned int participant);
+		bool next(unsigned int participant, std::size_t& task, const std::function<void(std::size_t)>*& function);
+		void execute(std::size_t task, const std::function<void(std::size_t)>& function);
+
+		std::vector<std::unique_ptr<Queue>> _queues;  // [participant]; the calling thread is participant 0
+		std::vector<std::thread> _threads;
+
+		std::mutex _run_mutex;  // Serializes `run()`
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		const std::function<void(std::size_t)>* _task;
+		std::size_t _remaining;
+		unsigned long long _generation;
+		bool _stopping;
+		std::exception_ptr _error;
+};
@@ -0,0 +1,56 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+#include "Geolocation.hpp"
+
+
+class JulianDate;
+class ThreadPool;
+
+
+class TideGrid
+/*
+Tide displacements over a regular latitude/longitude grid, e.g. a global 0.1° map every 10 minutes. Row `row` is at
+ `latitude(row)` (south to north) and column `column` at `longitude(column)` (west to east), both ends of the box
+ included when the resolution divides it.
+The grid is split into tiles of `TILE_ROWS` × `TILE_COLUMNS` points that a `ThreadPool` evaluates concurrently. The sun,
+ moon & `EpochContext` of every epoch are evaluated once for the whole grid; each tile builds the `Geolocation` &
+ `StationFrame` of its points once and reuses them for every epoch, so a point costs one `detide` per epoch. There are
+ many more tiles than threads, so threads that finish early steal tiles from the rest.
+*/
+{
+	public:
+		static const std::size_t TILE_ROWS;
+		static const std::size_t TILE_COLUMNS;
+
+		TideGrid(double south_degrees, double north_degrees, double west_degrees, double east_degrees,
+			double resolution_degrees
+		);
+
+		std::size_t rows();
+		std::size_t columns();
+		std::size_t size();  // rows() × columns()
+		double latitude(std::size_t row);  // Degrees
+		double longitude(std::size_t column);  // Degrees
+
+		void tide(std::vector<JulianDate>& epochs, double* x, double* y, double* z, ThreadPool& thread_pool,
+			Geolocation::LunarSeries lunar_series=Geolocation::LunarSeries::DIRECT
+		);
+
+	private:
+		static double validate(double south_degrees, double north_degrees, double west_degrees, double east_degrees,
+			double resolution_degrees
+		);
+
+		const double _south;  // Degrees
+		const double _west;  // Degrees
+		const double _resolution;  // Degrees
+		const std::size_t _rows;
+		const std::size_t _columns;
+};
@@ -0,0 +1,86 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+class TideSeriesFile
+/*
+A tide series on disk in a form that can be memory mapped & used without parsing: a fixed 128 byte `Header`, then the
+ three components as contiguous float64 arrays, each starting on a 64 byte boundary. All fields are in the writer's
+ byte order; `byte_order` reads as 0x01020304 when that is also the reader's. The components are in the header's
+ `units`, which a reader checks rather than assumes; only meters are written.
+
+| offset | size          | content                                                                      |
+|--------|---------------|------------------------------------------------------------------------------|
+| 0      | 128           | `Header`                                                                     |
+| a₀     | 8 × count     | component 0 (X or east) [m], a₀ = `component_offset[0]`                      |
+| a₁     | 8 × count     | component 1 (Y or north) [m]                                                 |
+| a₂     | 8 × count     | component 2 (Z or up) [m]                                                    |
+
+Sample `index` is the UTC epoch `modified_julian_date` + `fractional_modified_julian_date` + `index` × `step_seconds`.
+ E.g. with numpy: `numpy.memmap(path, '<f8', 'r', offset=a₀, shape=(count,))`.
+Opening a file maps it read-only; the arrays stay valid for the life of the object. `write()` writes a whole series,
+ a `TideSeriesWriter` one a part at a time.
+*/
+{
+	public:
+		static const char MAGIC[8];  // "SETIDE\0\1"
+		static const std::uint32_t VERSION;  // 2: `units` (reserved in 1)
+		static const std::uint32_t BYTE_ORDER_MARK;  // 0x01020304
+		static const std::size_t ALIGNMENT = 64;  // Of each component's array
+
+		enum class Frame : std::uint32_t
+		{
+			ECEF = 0,  // X, Y, Z
+			ENU = 1  // east, north, up at the station
+		};
+
+		enum class Units : std::uint32_t
+		{
+			METERS = 1  // Not 0, so that a zeroed field is not taken for a unit
+		};
+
+		struct Header
+		{
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t header_bytes;
+			std::uint32_t frame;  // `Frame`
+			double latitude_degrees;  // Station, geodetic
+			double longitude_degrees;
+			double height_meters;  // Ellipsoidal
+			std::uint32_t modified_julian_date;  // First sample, UTC
+			std::uint32_t units;  // `Units`, of the components
+			double fractional_modified_julian_date;
+			double step_seconds;
+			std::uint64_t count;
+			std::uint64_t component_offset[3];  // Bytes from the start of the file
+			std::uint8_t padding[24];
+		};
+
+		TideSeriesFile(const std::string& path);
+		TideSeriesFile(const TideSeriesFile&) = delete;
+		TideSeriesFile& operator=(const TideSeriesFile&) = delete;
+		~TideSeriesFile();
+
+		static void write(const std::string& path, double latitude_degrees, double longitude_degrees,
+			double height_meters, unsigned int modified_julian_date, double fractional_modified_julian_date,
+			double step_seconds, std::size_t count, Frame frame, const double* component0, const double* component1,
+			const double* component2
+		);
+
+		const Header& header();
+		std::size_t count();
+		const double* component(unsigned int index);  // 0, 1 or 2
+
+	private:
+		void* _map;
+		std::size_t _map_bytes;
+		const Header* _header;
+};
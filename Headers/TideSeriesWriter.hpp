@@ -0,0 +1,41 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+#include "TideSeriesFile.hpp"
+
+
+class TideSeriesWriter
+/*
+Writes a `TideSeriesFile` a part at a time, so that a series never has to be held whole: the constructor writes the
+ header & sizes the file for all `count` samples (the padding reads as zeros), and `write()` puts samples of each
+ component in their places, in any order.
+*/
+{
+	public:
+		TideSeriesWriter(const std::string& path, double latitude_degrees, double longitude_degrees,
+			double height_meters, unsigned int modified_julian_date, double fractional_modified_julian_date,
+			double step_seconds, std::size_t count, TideSeriesFile::Frame frame
+		);
+		TideSeriesWriter(const TideSeriesWriter&) = delete;
+		TideSeriesWriter& operator=(const TideSeriesWriter&) = delete;
+		~TideSeriesWriter();
+
+		void write(std::size_t first, std::size_t count, const double* component0, const double* component1,
+			const double* component2
+		);
+
+	private:
+		void write(const void* data, std::size_t bytes, std::uint64_t offset);
+
+		const std::string _path;
+		const int _file_descriptor;
+		const std::size_t _count;
+		std::uint64_t _component_offset[3];
+};
@@ -0,0 +1,155 @@
+
+
+#pragma once
+
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+
+
+class TideServer
+/*
+A long-running process that answers (station, epoch) tide queries over a local Unix stream socket, so that online
+ processing pays for startup, station frames & ephemerides once instead of once per request.
+A client writes any number of 48 byte `Query` records & reads one 40 byte `Response` per query, matched by `id`. Both
+ are in the host's byte order; responses to one batch may arrive in any order. Components are ECEF X, Y, Z or (with
+ `frame` 1, as `TideSeriesFile::Frame::ENU`) east, north, up [m].
+Every query that has arrived by the time the server looks (or within `coalesce_microseconds` of the first one) is one
+ batch: queries for the same epoch share one `EpochContext`, sun & moon, and the last `EPOCH_CACHE` epochs stay warm
+ for the next batches. Station frames are kept for the last `STATION_CACHE` stations seen. Batches of at least
+ `PARALLEL_BATCH` queries are spread over the thread pool.
+A client that does not read its responses is not read from while its unsent (& pending) responses exceed
+ `OUTPUT_LIMIT` bytes, so that it cannot grow the server's buffers without bound.
+The latency of each query (from reading it to queueing its response) is kept for the last `LATENCY_SAMPLES` queries;
+ p50 & p99 are written to standard error every `REPORT_SECONDS` while queries arrive, and when the server stops.
+*/
+{
+	public:
+		static const std::size_t EPOCH_CACHE;  // 4096 epochs
+		static const std::size_t STATION_CACHE;  // 65536 stations
+		static const std::size_t OUTPUT_LIMIT;  // 1 MiB of responses per client
+		static const std::size_t LATENCY_SAMPLES;  // 65536 queries
+		static const std::size_t PARALLEL_BATCH;  // 64 queries
+		static const unsigned int REPORT_SECONDS;  // 10 s
+
+		enum class Status : std::uint32_t
+		{
+			OK = 0,
+			INVALID = 1  // Coordinates, epoch or frame out of range; the displacement is zero
+		};
+
+		struct Query
+		{
+			std::uint64_t id;  // Returned in the response
+			double latitude_degrees;  // [-90, +90], geodetic
+			double longitude_degrees;  // [-360, +360]
+			double height_meters;  // Ellipsoidal
+			std::uint32_t modified_julian_date;  // UTC
+			std::uint32_t frame;  // `TideSeriesFile::Frame`
+			double fractional_modified_julian_date;  // [0, 1)
+		};
+
+		struct Response
+		{
+			std::uint64_t id;
+			std::uint32_t status;  // `Status`
+			std::uint32_t leap_second_flag;  // 1 outside the leap second table (solid.f's `lflag`)
+			double displacement[3];  // [m]
+		};
+
+		TideServer(const std::string& socket_path, unsigned int threads=0, unsigned int coalesce_microseconds=0);
+		TideServer(const TideServer&) = delete;
+		TideServer& operator=(const TideServer&) = delete;
+		~TideServer();
+
+		static void stop(int signal=0);  // May be a signal handler or another thread; wakes `run()` at once
+		void run();  // Until `stop()`
+		std::string latency_report();
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+		typedef std::tuple<double, double, double> Coordinates;  // Latitude, longitude, height
+		typedef std::pair<std::uint32_t, double> EpochKey;  // MJD, fractional MJD
+
+		struct Client
+		{
+			int descriptor;  // -1 once closed
+			std::vector<char> input;  // Bytes of an incomplete query
+			std::vector<char> output;  // Responses not yet sent
+			std::size_t pending;  // Queries read but not yet answered
+		};
+
+		struct Station
+		{
+			Station(const Query& query);
+
+			Geolocation geolocation;
+			const StationFrame station_frame;
+		};
+
+		struct Epoch
+		{
+			Epoch(const EpochKey& key);
+
+			const EpochContext epoch_context;
+			Coordinate<double> solar_coordinate;
+			Coordinate<double> lunar_coordinate;
+		};
+
+		struct Pending
+		{
+			std::size_t client;
+			Query query;
+			Clock::time_point received;
+			Station* station;
+			const Epoch* epoch;
+			Response response;
+		};
+
+		void accept_clients();
+		static std::size_t readable_bytes(const Client& client);
+		void read_client(std::size_t client, Clock::time_point now);
+		void evaluate();
+		void answer(Pending& pending);
+		void send_output(Client& client);
+		void close_client(Client& client);
+		void report(Clock::time_point now);
+
+		static volatile std::sig_atomic_t _stop_requested;
+		static volatile std::sig_atomic_t _stop_descriptor;  // `_stop_pipe[1]` of the server, -1 without one
+
+		const std::string _socket_path;
+		const unsigned int _coalesce_microseconds;
+		int _listener;
+		int _stop_pipe[2];  // Written by `stop()`, so that a stop between checking for it & `ppoll` still wakes it
+		ThreadPool _thread_pool;
+
+		std::vector<Client> _clients;
+		std::vector<Pending> _pending;
+		std::map<Coordinates, std::unique_ptr<Station>> _stations;
+		std::deque<Coordinates> _station_order;  // Oldest first, for eviction
+		std::map<EpochKey, std::unique_ptr<Epoch>> _epochs;
+		std::deque<EpochKey> _epoch_order;  // Oldest first, for eviction
+
+		std::vector<double> _latencies;  // Microseconds, a ring of the last `LATENCY_SAMPLES`
+		std::size_t _queries;
+		std::size_t _batches;
+		std::size_t _reported_queries;
+		Clock::time_point _last_report;
+};
@@ -0,0 +1,50 @@
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+#include "EpochContext.hpp"
+
+
+class JulianDate;
+
+
+class UniformEpochs
+/*
+The `EpochContext`s of a series of UTC epochs `step_seconds` apart, as `main()` & solid.f's 1 minute loop run. Within a
+ UTC day every angle of the context (the Greenwich hour angle, the step 2 & lunar arguments) is linear in time to well
+ below the model's precision, so each sample's sines & cosines are advanced from the previous sample's by a constant
+ rotation instead of calling `sin`/`cos` again.
+The recurrence is re-anchored (evaluated directly) at every sample whose index is a multiple of `anchor_interval()` and
+ at the first sample of every UTC day, so that the leap second & the day's hour angle are exact. The interval is the
+ longest (a power of two, at most `MAX_ANCHOR_INTERVAL`) over which the rounding the recurrence builds up in any angle
+ is bounded by `ANGLE_TOLERANCE`. A sample's value depends only on its index, never on where a caller started asking,
+ so any partition of the series gives the same contexts.
+*/
+{
+	public:
+		static const std::size_t MAX_ANCHOR_INTERVAL = 256;  // Samples
+		static const double ANGLE_TOLERANCE;  // 1e-10 radians: ~1e-4 µm of displacement
+
+		UniformEpochs(unsigned int modified_julian_date, double fractional_modified_julian_date, double step_seconds);
+
+		static std::size_t anchor_interval(double step_seconds);
+
+		JulianDate julian_date(std::size_t index) const;
+		std::size_t anchor_interval() const;
+		std::size_t anchor(std::size_t index) const;
+		void epochs(std::size_t first, std::size_t count, std::vector<EpochContext>& epoch_contexts) const;
+
+	private:
+		double day(std::size_t index) const;
+		EpochContext anchor_context(std::size_t index, EpochContext::Step& step) const;
+
+		const unsigned int _modified_julian_date;
+		const double _start_seconds;  // Seconds of the first sample from the start of `_modified_julian_date`
+		const double _step_seconds;
+		const std::size_t _anchor_interval;
+};
@@ -0,0 +1,341 @@
+
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+#include "SolidEarthTideC.h"
+
+
+/*
+The `solidearthtide` CPython extension (`make python`): `solid_earth_tide_evaluate()` over buffer-protocol arrays
+ (NumPy arrays, `array.array`, `memoryview`s…), read & written in place. Python objects are only created for the
+ result, never per element, and the GIL is released while the engine runs.
+*/
+
+
+class Buffer
+/*
+A C-contiguous buffer of `Py_buffer`, released when it goes out of scope.
+*/
+{
+	public:
+		Buffer()
+		: _held{false}
+		{}
+
+
+		~Buffer()
+		{
+			if(_held)
+			{
+				PyBuffer_Release(&view);
+			}
+		}
+
+
+		bool get(PyObject* object, const char* name, bool writable)
+		/*
+		False (with a Python exception set) if `object` does not export a C-contiguous buffer.
+		*/
+		{
+			int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+			if(PyObject_GetBuffer(object, &view, flags) != 0)
+			{
+				PyErr_Format(PyExc_TypeError, "%s must be a C-contiguous%s buffer", name, writable ? " writable" : "");
+				return false;
+			}
+			_held = true;
+			return true;
+		}
+
+
+		char type() const
+		/*
+		The `struct` code of the elements, without a native or little-endian byte order prefix; 0 for anything else.
+		*/
+		{
+			const char* format = view.format ? view.format : "B";
+			if(*format == '@' || *format == '=' || (*format == '<' && PY_LITTLE_ENDIAN))
+			{
+				format++;
+			}
+			return format[0] && !format[1] ? format[0] : 0;
+		}
+
+
+		Py_ssize_t count() const
+		{
+			return view.itemsize ? view.len / view.itemsize : 0;
+		}
+
+
+		Py_buffer view;
+
+	private:
+		bool _held;
+};
+
+
+static bool doubles(Buffer& buffer, PyObject* object, const char* name, Py_ssize_t count, bool writable)
+{
+	if(!buffer.get(object, name, writable))
+	{
+		return false;
+	}
+	if(buffer.type() != 'd' || buffer.view.itemsize != sizeof(double))
+	{
+		PyErr_Format(PyExc_TypeError, "%s must hold float64 values", name);
+		return false;
+	}
+	if(count >= 0 && buffer.count() != count)
+	{
+		PyErr_Format(PyExc_ValueError, "%s must hold %zd values, not %zd", name, count, buffer.count());
+		return false;
+	}
+	return true;
+}
+
+
+static bool modified_julian_dates(Buffer& buffer, PyObject* object, Py_ssize_t count,
+	std::vector<std::int32_t>& converted, const std::int32_t*& dates
+)
+/*
+`dates` points into an int32 `buffer` directly; int64 (& other integer) buffers are narrowed into `converted`.
+*/
+{
+	if(!buffer.get(object, "modified_julian_dates", false))
+	{
+		return false;
+	}
+	if(buffer.count() != count)
+	{
+		PyErr_Format(PyExc_ValueError, "modified_julian_dates must hold %zd values, not %zd", count, buffer.count());
+		return false;
+	}
+
+	char type = buffer.type();
+	if(type == 0 || !std::strchr("bBhHiIlLqQ", type))
+	{
+		PyErr_SetString(PyExc_TypeError, "modified_julian_dates must hold integers");
+		return false;
+	}
+	if((type == 'i' || type == 'l') && buffer.view.itemsize == sizeof(std::int32_t))
+	{
+		dates = static_cast<const std::int32_t*>(buffer.view.buf);
+		return true;
+	}
+
+	bool is_signed = std::strchr("bhilq", type) != nullptr;
+	converted.resize(count);
+	for(Py_ssize_t index = 0; index < count; index++)
+	{
+		const char* element = static_cast<const char*>(buffer.view.buf) + index * buffer.view.itemsize;
+		long long value = 0;
+		switch(buffer.view.itemsize)
+		{
+			case 1:
+				value = is_signed ? *reinterpret_cast<const std::int8_t*>(element)
+					: *reinterpret_cast<const std::uint8_t*>(element);
+				break;
+			case 2:
+				value = is_signed ? *reinterpret_cast<const std::int16_t*>(element)
+					: *reinterpret_cast<const std::uint16_t*>(element);
+				break;
+			case 4:
+				value = is_signed ? *reinterpret_cast<const std::int32_t*>(element)
+					: *reinterpret_cast<const std::uint32_t*>(element);
+				break;
+			default:
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, element, sizeof(bits));
+				value = is_signed || bits <= INT32_MAX ? static_cast<long long>(bits) : -1;
+			}
+		}
+		// Out of range values become -1, which the engine rejects
+		converted[index] = INT32_MIN <= value && value <= INT32_MAX ? static_cast<std::int32_t>(value) : -1;
+	}
+	dates = converted.data();
+	return true;
+}
+
+
+static PyObject* evaluate(PyObject*, PyObject* arguments, PyObject* keywords)
+{
+	static const char* names[] = {"latitudes", "longitudes", "modified_julian_dates",
+		"fractional_modified_julian_dates", "heights", "frame", "threads", "out", "leap_second_flags", nullptr};
+	PyObject *latitudes_object, *longitudes_object, *dates_object, *fractions_object;
+	PyObject *heights_object = Py_None, *out_object = Py_None, *flags_object = Py_None;
+	const char* frame_name = "enu";
+	unsigned int threads = 0;
+	if(!PyArg_ParseTupleAndKeywords(arguments, keywords, "OOOO|$OsIOO:evaluate", const_cast<char**>(names),
+		&latitudes_object, &longitudes_object, &dates_object, &fractions_object, &heights_object, &frame_name, &threads,
+		&out_object, &flags_object)
+	)
+	{
+		return nullptr;
+	}
+
+	int frame;
+	if(std::strcmp(frame_name, "enu") == 0)
+	{
+		frame = SOLID_EARTH_TIDE_ENU;
+	}
+	else if(std::strcmp(frame_name, "ecef") == 0)
+	{
+		frame = SOLID_EARTH_TIDE_ECEF;
+	}
+	else
+	{
+		return PyErr_Format(PyExc_ValueError, "frame must be 'enu' or 'ecef', not '%s'", frame_name);
+	}
+
+	Buffer latitudes, longitudes, heights, fractions, dates_buffer;
+	if(!doubles(latitudes, latitudes_object, "latitudes", -1, false))
+	{
+		return nullptr;
+	}
+	Py_ssize_t stations = latitudes.count();
+	if(!doubles(longitudes, longitudes_object, "longitudes", stations, false)
+	  || (heights_object != Py_None && !doubles(heights, heights_object, "heights", stations, false))
+	  || !doubles(fractions, fractions_object, "fractional_modified_julian_dates", -1, false)
+	)
+	{
+		return nullptr;
+	}
+	Py_ssize_t epochs = fractions.count();
+	std::vector<std::int32_t> converted_dates;
+	const std::int32_t* dates;
+	if(!modified_julian_dates(dates_buffer, dates_object, epochs, converted_dates, dates))
+	{
+		return nullptr;
+	}
+
+	// Without `out`, a bytearray viewed as float64 [3][stations][epochs]
+	PyObject* result;
+	if(out_object == Py_None)
+	{
+		PyObject* bytes = PyByteArray_FromStringAndSize(nullptr, 3 * stations * epochs * sizeof(double));
+		PyObject* bytes_view = bytes ? PyMemoryView_FromObject(bytes) : nullptr;
+		Py_XDECREF(bytes);
+		result = bytes_view ? PyObject_CallMethod(bytes_view, "cast", "s(nnn)", "d", Py_ssize_t(3), stations, epochs)
+			: nullptr;
+		Py_XDECREF(bytes_view);
+		if(!result)
+		{
+			return nullptr;
+		}
+	}
+	else
+	{
+		Py_INCREF(out_object);
+		result = out_object;
+	}
+
+	Buffer out, flags;
+	if(!doubles(out, result, "out", 3 * stations * epochs, true))
+	{
+		Py_DECREF(result);
+		return nullptr;
+	}
+	if(flags_object != Py_None)
+	{
+		if(!flags.get(flags_object, "leap_second_flags", true) || flags.view.itemsize != 1 || flags.count() != epochs)
+		{
+			PyErr_Clear();
+			PyErr_Format(PyExc_ValueError, "leap_second_flags must be a writable byte buffer of %zd values", epochs);
+			Py_DECREF(result);
+			return nullptr;
+		}
+	}
+
+	double* x = static_cast<double*>(out.view.buf);
+	int status;
+	Py_BEGIN_ALLOW_THREADS
+	status = solid_earth_tide_evaluate(static_cast<const double*>(latitudes.view.buf),
+		static_cast<const double*>(longitudes.view.buf),
+		heights_object != Py_None ? static_cast<const double*>(heights.view.buf) : nullptr, stations, dates,
+		static_cast<const double*>(fractions.view.buf), epochs, frame, threads, x, x + stations * epochs,
+		x + 2 * stations * epochs, flags_object != Py_None ? static_cast<std::uint8_t*>(flags.view.buf) : nullptr);
+	Py_END_ALLOW_THREADS
+
+	if(status != SOLID_EARTH_TIDE_OK)
+	{
+		Py_DECREF(result);
+		PyObject* type = status == SOLID_EARTH_TIDE_INVALID_ARGUMENT ? PyExc_ValueError : PyExc_RuntimeError;
+		return PyErr_Format(type, "%s", solid_earth_tide_status_message(status));
+	}
+	return result;
+}
+
+
+static PyObject* load_leap_seconds(PyObject*, PyObject* arguments)
+{
+	const char* path;
+	if(!PyArg_ParseTuple(arguments, "s:load_leap_seconds", &path))
+	{
+		return nullptr;
+	}
+
+	int status = solid_earth_tide_load_leap_seconds(path);
+	if(status == SOLID_EARTH_TIDE_FILE_ERROR)
+	{
+		return PyErr_Format(PyExc_OSError, "%s: %s", solid_earth_tide_status_message(status), path);
+	}
+	if(status != SOLID_EARTH_TIDE_OK)
+	{
+		return PyErr_Format(PyExc_RuntimeError, "%s", solid_earth_tide_status_message(status));
+	}
+	Py_RETURN_NONE;
+}
+
+
+static PyMethodDef METHODS[] =
+{
+	{
+		"evaluate", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(evaluate)),
+		METH_VARARGS | METH_KEYWORDS,
+		"evaluate(latitudes, longitudes, modified_julian_dates, fractional_modified_julian_dates, *, heights=None,\n"
+		"  frame='enu', threads=0, out=None, leap_second_flags=None)\n"
+		"--\n\n"
+		"Tide displacements [m] of every station at every UTC epoch.\n\n"
+		"Stations are float64 buffers of geodetic latitudes & longitudes [degrees] and optional heights [m]; epochs an\n"
+		"integer buffer of MJDs & a float64 buffer of day fractions [0, 1). The result is float64 [3][stations][epochs]:\n"
+		"east, north, up for frame 'enu', X, Y, Z for 'ecef'. It is written into `out` (any writable C-contiguous\n"
+		"float64 buffer of that size, which is returned) or a new memoryview. `leap_second_flags`, a writable byte\n"
+		"buffer of one per epoch, gets solid.f's lflag. threads=0 uses every hardware thread."
+	},
+	{
+		"load_leap_seconds", load_leap_seconds, METH_VARARGS,
+		"load_leap_seconds(path)\n--\n\nReplaces the built-in leap second table with an IERS Leap_Second.dat. The\n"
+		"built-in one expires on 2026-06-28; later epochs raise leap_second_flags until a current file is loaded."
+	},
+	{nullptr, nullptr, 0, nullptr}
+};
+
+
+static PyModuleDef MODULE =
+{
+	PyModuleDef_HEAD_INIT, "solidearthtide",
+	"Solid Earth tide (solid.f) batch evaluation over buffer-protocol arrays.", -1, METHODS,
+	nullptr, nullptr, nullptr, nullptr
+};
+
+
+PyMODINIT_FUNC PyInit_solidearthtide(void)
+{
+	PyObject* module = PyModule_Create(&MODULE);
+	if(module && PyModule_AddIntConstant(module, "ABI_VERSION", solid_earth_tide_abi_version()) != 0)
+	{
+		Py_DECREF(module);
+		return nullptr;
+	}
+	return module;
+}
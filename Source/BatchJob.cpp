@@ -0,0 +1,612 @@
+
+
+#include "BatchJob.hpp"
+
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+
+#include "Datetime.hpp"
+#include "Geolocation.hpp"
+#include "JobPlanner.hpp"
+#include "JulianDate.hpp"
+#include "LeapSecondTable.hpp"
+#include "SolidTextWriter.hpp"
+#include "StationCatalog.hpp"
+#include "ThreadPool.hpp"
+#include "TideSeriesWriter.hpp"
+#include "TideServer.hpp"
+
+
+const char BatchJob::USAGE[] =
+	"Usage: SolidEarthTide [--job FILE] [--station LAT,LON[,HEIGHT[,NAME]]]... --start YYYY-MM-DD[Thh:mm[:ss]]\n"
+	"         [--end YYYY-MM-DD[Thh:mm[:ss]]] [--step SECONDS] [--format text|binary] [--frame enu|ecef]\n"
+	"         [--output DIRECTORY] [--threads N] [--leap-seconds FILE] [--series STATION,START,END[,STEP[,NAME]]]...\n"
+	"         [--catalog FILE]...\n"
+	"       SolidEarthTide --serve SOCKET [--threads N] [--coalesce-us MICROSECONDS] [--leap-seconds FILE]\n"
+	"Without arguments, asks for one station & day as solid.f does.\n";
+const std::size_t BatchJob::SETTING = static_cast<std::size_t>(-1);
+
+
+static double number(const std::string& text, const std::string& what)
+{
+	std::size_t length = 0;
+	double value = 0.0;
+	try
+	{
+		value = std::stod(text, &length);
+	}
+	catch(std::exception&)
+	{
+		length = 0;
+	}
+	if(length == 0 || length != text.size() || !std::isfinite(value))
+	{
+		throw std::runtime_error("Expected a number for " + what + ", not '" + text + "'");
+	}
+	return value;
+}
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+BatchJob::BatchJob(int argument_count, char* arguments[])
+: _has_start{false}, _start_modified_julian_date{0}, _start_seconds{0.0}, _has_end{false},
+  _end_modified_julian_date{0}, _end_seconds{0.0}, _step_seconds{60.0}, _format{Format::TEXT},
+  _frame{TideSeriesFile::Frame::ENU}, _output{"."}, _threads{0},
+  _coalesce_microseconds{0}
+{
+	for(int index = 1; index < argument_count; index++)
+	{
+		std::string flag = arguments[index];
+		if(flag.size() < 3 || flag.compare(0, 2, "--") != 0)
+		{
+			throw std::runtime_error("Unexpected argument '" + flag + "'");
+		}
+		if(index + 1 == argument_count)
+		{
+			throw std::runtime_error("Missing value for " + flag);
+		}
+		index++;
+		if(flag == "--job")
+		{
+			read(arguments[index]);
+		}
+		else
+		{
+			set(flag.substr(2), arguments[index]);
+		}
+	}
+}
+
+
+BatchJob::~BatchJob()
+{}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+std::uint64_t BatchJob::hash(const std::string& name)
+/*
+64 bit FNV-1a.
+*/
+{
+	std::uint64_t hash = 0xCBF29CE484222325ull;
+	for(unsigned char character : name)
+	{
+		hash = (hash ^ character) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void BatchJob::run()
+/*
+Plans every series with one `JobPlanner` & evaluates them with all threads, writing each chunk the planner hands back
+ to its series' file as it comes, so that only the files of the series being evaluated are open. With `serve`, runs a
+ `TideServer` instead.
+*/
+{
+	if(!_serve.empty())
+	{
+		TideServer tide_server(_serve, _threads, _coalesce_microseconds);
+		std::signal(SIGINT, TideServer::stop);
+		std::signal(SIGTERM, TideServer::stop);
+		tide_server.run();
+		return;
+	}
+
+	if(_stations.empty())
+	{
+		throw std::runtime_error("No stations given");
+	}
+	if(_format == Format::TEXT && _frame != TideSeriesFile::Frame::ENU)
+	{
+		throw std::runtime_error("Text output is always in the local frame (north, east, up)");
+	}
+	index_names();
+
+	std::vector<Series> series;
+	if(_series.empty())
+	{
+		if(!_has_start)
+		{
+			throw std::runtime_error("No start time given");
+		}
+		unsigned int end_modified_julian_date = _has_end ? _end_modified_julian_date : _start_modified_julian_date + 1;
+		double end_seconds = _has_end ? _end_seconds : _start_seconds;
+		std::size_t samples = count(_start_modified_julian_date, _start_seconds, end_modified_julian_date, end_seconds,
+			_step_seconds);
+		for(std::size_t station = 0; station < _stations.size(); station++)
+		{
+			series.push_back(Series{std::string(), station, _start_modified_julian_date, _start_seconds,
+				_step_seconds, samples});
+		}
+	}
+
+	for(std::size_t series_number = 1; series_number <= _series.size(); series_number++)
+	{
+		const std::string& value = _series[series_number - 1];
+		std::string fields_text = value;
+		std::replace(fields_text.begin(), fields_text.end(), ',', ' ');
+		std::istringstream fields(fields_text);
+		std::string station_name, start, end, step, name, extra;
+		fields >> station_name >> start >> end >> step >> name >> extra;
+		if(end.empty() || !extra.empty())
+		{
+			throw std::runtime_error("Expected 'station, start, end [, step [, name]]' for series '" + value + "'");
+		}
+
+		Series entry;
+		entry.station = find(station_name);
+		if(entry.station == _stations.size())
+		{
+			throw std::runtime_error("Series '" + value + "' is for an unknown station");
+		}
+
+		unsigned int end_modified_julian_date;
+		double end_seconds;
+		epoch(start, entry.modified_julian_date, entry.start_seconds);
+		epoch(end, end_modified_julian_date, end_seconds);
+		entry.step_seconds = step.empty() ? _step_seconds : number(step, "the series step");
+		if(!(entry.step_seconds > 0.0))
+		{
+			throw std::runtime_error("The step of series '" + value + "' must be a positive number of seconds");
+		}
+		entry.count = count(entry.modified_julian_date, entry.start_seconds, end_modified_julian_date, end_seconds,
+			entry.step_seconds);
+		entry.name = name.empty() ? station_name + "-" + std::to_string(series_number) : name;
+		if(entry.name.find('/') != std::string::npos)
+		{
+			throw std::runtime_error("Series names cannot contain '/': '" + entry.name + "'");
+		}
+		for(const Series& other : series)
+		{
+			if(other.name == entry.name)
+			{
+				throw std::runtime_error("Two series are named '" + entry.name + "'");
+			}
+		}
+		series.push_back(entry);
+	}
+
+	JobPlanner job_planner;
+	for(const Series& entry : series)
+	{
+		const Station& station = _stations[entry.station];
+		std::size_t planner_station = job_planner.station(station.latitude_degrees, station.longitude_degrees,
+			station.height_meters);
+		job_planner.request(planner_station, entry.modified_julian_date, entry.start_seconds, entry.step_seconds,
+			entry.count);  // Request `index` is `series[index]`
+	}
+
+	// The series that have had some of their samples, until they have had all of them
+	std::map<std::size_t, std::unique_ptr<SolidTextWriter>> text_writers;
+	std::map<std::size_t, std::unique_ptr<TideSeriesWriter>> binary_writers;
+	std::vector<double> north, east, up;
+
+	ThreadPool thread_pool(_threads);
+	job_planner.run(thread_pool,
+		[&](std::size_t index, std::size_t first, std::size_t count, const double* x, const double* y, const double* z)
+		{
+			const Series& entry = series[index];
+			const Station& station = _stations[entry.station];
+			if(_frame == TideSeriesFile::Frame::ENU)
+			{
+				north.resize(count);
+				east.resize(count);
+				up.resize(count);
+				Geolocation location(station.latitude_degrees, station.longitude_degrees, station.height_meters);
+				location.local_horizon(count, x, y, z, north.data(), east.data(), up.data());
+			}
+
+			std::string path = _output + "/" + (entry.name.empty() ? name(entry.station) : entry.name);
+			bool last = first + count == entry.count;
+			if(_format == Format::TEXT)
+			{
+				std::unique_ptr<SolidTextWriter>& solid_text = text_writers[index];
+				if(!solid_text)
+				{
+					solid_text.reset(new SolidTextWriter(path + ".txt"));
+				}
+				// A header & seconds of the day per UTC day, as solid.f writes its one day
+				solid_text->daily_series(entry.modified_julian_date, entry.start_seconds + first * entry.step_seconds,
+					entry.step_seconds, count, north.data(), east.data(), up.data(), station.latitude_degrees,
+					station.longitude_degrees);
+				if(last)
+				{
+					solid_text->flush();
+					text_writers.erase(index);
+				}
+				return;
+			}
+
+			std::unique_ptr<TideSeriesWriter>& tide_series = binary_writers[index];
+			if(!tide_series)
+			{
+				tide_series.reset(new TideSeriesWriter(path + ".tide", station.latitude_degrees,
+					station.longitude_degrees, station.height_meters, entry.modified_julian_date,
+					entry.start_seconds / 86400.0, entry.step_seconds, entry.count, _frame));
+			}
+			if(_frame == TideSeriesFile::Frame::ENU)
+			{
+				tide_series->write(first, count, east.data(), north.data(), up.data());
+			}
+			else
+			{
+				tide_series->write(first, count, x, y, z);
+			}
+			if(last)
+			{
+				binary_writers.erase(index);
+			}
+		}
+	);
+}
+
+
+void BatchJob::set(const std::string& key, const std::string& value)
+{
+	if(key == "station")
+	{
+		std::string fields_text = value;
+		std::replace(fields_text.begin(), fields_text.end(), ',', ' ');
+		std::istringstream fields(fields_text);
+		std::string latitude, longitude, height, name, extra;
+		fields >> latitude >> longitude >> height >> name >> extra;
+		if(longitude.empty() || !extra.empty())
+		{
+			throw std::runtime_error("Expected 'latitude, longitude [, height [, name]]' for station '" + value + "'");
+		}
+
+		_station_names.push_back(name);
+		add(SETTING, _station_names.size() - 1, number(latitude, "the station latitude"),
+			number(longitude, "the station longitude"), height.empty() ? 0.0 : number(height, "the station height"));
+	}
+	else if(key == "catalog")
+	{
+		_catalogs.emplace_back(new StationCatalog(value));
+		const StationCatalog& station_catalog = *_catalogs.back();
+		_stations.reserve(_stations.size() + station_catalog.size());
+		for(std::size_t index = 0; index < station_catalog.size(); index++)
+		{
+			add(_catalogs.size() - 1, index, station_catalog.latitudes()[index], station_catalog.longitudes()[index],
+				station_catalog.heights()[index]);
+		}
+	}
+	else if(key == "start")
+	{
+		epoch(value, _start_modified_julian_date, _start_seconds);
+		_has_start = true;
+	}
+	else if(key == "end")
+	{
+		epoch(value, _end_modified_julian_date, _end_seconds);
+		_has_end = true;
+	}
+	else if(key == "step")
+	{
+		_step_seconds = number(value, "the step");
+		if(!(_step_seconds > 0.0))
+		{
+			throw std::runtime_error("The step must be a positive number of seconds");
+		}
+	}
+	else if(key == "format")
+	{
+		if(value != "text" && value != "binary")
+		{
+			throw std::runtime_error("The format must be 'text' or 'binary', not '" + value + "'");
+		}
+		_format = value == "text" ? Format::TEXT : Format::BINARY;
+	}
+	else if(key == "frame")
+	{
+		if(value != "enu" && value != "ecef")
+		{
+			throw std::runtime_error("The frame must be 'enu' or 'ecef', not '" + value + "'");
+		}
+		_frame = value == "enu" ? TideSeriesFile::Frame::ENU : TideSeriesFile::Frame::ECEF;
+	}
+	else if(key == "output")
+	{
+		_output = value;
+	}
+	else if(key == "threads")
+	{
+		double threads = number(value, "threads");
+		if(threads < 0.0 || threads != std::floor(threads) || threads > 4096.0)
+		{
+			throw std::runtime_error("Threads must be a whole number in [0, 4096], not '" + value + "'");
+		}
+		_threads = static_cast<unsigned int>(threads);
+	}
+	else if(key == "leap-seconds")
+	{
+		LeapSecondTable::load(value);
+	}
+	else if(key == "series")
+	{
+		_series.push_back(value);
+	}
+	else if(key == "serve")
+	{
+		_serve = value;
+	}
+	else if(key == "coalesce-us")
+	{
+		double microseconds = number(value, "the coalescing window");
+		if(microseconds < 0.0 || microseconds != std::floor(microseconds) || microseconds > 1e6)
+		{
+			throw std::runtime_error("The coalescing window must be a whole number of microseconds in [0, 1000000], "
+				"not '" + value + "'");
+		}
+		_coalesce_microseconds = static_cast<unsigned int>(microseconds);
+	}
+	else
+	{
+		throw std::runtime_error("Unknown setting '" + key + "'");
+	}
+}
+
+
+void BatchJob::add(std::size_t catalog, std::size_t position, double latitude_degrees, double longitude_degrees,
+	double height_meters
+)
+/*
+solid.f [LN 42–53]
+```
+|    4 write(*,'(a$)') 'Lat. (pos N.) [- 90, +90]: '
+|      read(*,*) glad
+|      if(glad.lt.-90.d0.or.glad.gt.90.d0) go to 4
+|
+|    5 write(*,'(a$)') 'Lon. (pos E.) [-360,+360]: '
+|      read(*,*) glod
+|      if(glod.lt.-360.d0.or.glod.gt.360.d0) go to 5
+⋮
+|      if(glod.lt.  0.d0) glod=glod+360.d0
+|      if(glod.ge.360.d0) glod=glod-360.d0
+```
+Adds station `position` of `_catalogs[catalog]` (or of `_station_names` for `SETTING`). Names are checked once all
+ stations are known, by `index_names()`.
+*/
+{
+	_stations.push_back(Station{catalog, position, latitude_degrees, longitude_degrees, height_meters});
+	Station& station = _stations.back();
+	if(!(-90.0 <= latitude_degrees && latitude_degrees <= 90.0))
+	{
+		std::string station_name = name(_stations.size() - 1);
+		_stations.pop_back();
+		throw std::runtime_error("Latitude of station '" + station_name + "' must be in [-90, +90]");
+	}
+	if(!(-360.0 <= longitude_degrees && longitude_degrees <= 360.0))
+	{
+		std::string station_name = name(_stations.size() - 1);
+		_stations.pop_back();
+		throw std::runtime_error("Longitude of station '" + station_name + "' must be in [-360, +360]");
+	}
+	station.longitude_degrees = Geolocation::east_longitude(station.longitude_degrees);
+}
+
+
+std::string BatchJob::name(std::size_t station) const
+/*
+The station's name from its catalog (or `station` setting); an empty one becomes `station<number>`.
+*/
+{
+	const Station& entry = _stations[station];
+	std::string station_name = entry.catalog == SETTING ? _station_names[entry.position]
+		: _catalogs[entry.catalog]->name(entry.position);
+	return station_name.empty() ? "station" + std::to_string(station + 1) : station_name;
+}
+
+
+void BatchJob::index_names()
+/*
+Sorts the stations by the hash of their names into `_name_index` for `find()`, & rejects names that cannot be file
+ names or that two stations share. Names are made one at a time & not kept.
+*/
+{
+	_name_index.clear();
+	_name_index.reserve(_stations.size());
+	for(std::size_t station = 0; station < _stations.size(); station++)
+	{
+		std::string station_name = name(station);
+		if(station_name.find('/') != std::string::npos)
+		{
+			throw std::runtime_error("Station names cannot contain '/': '" + station_name + "'");
+		}
+		_name_index.push_back(std::make_pair(hash(station_name), station));
+	}
+	std::sort(_name_index.begin(), _name_index.end());
+
+	// Stations that share a name share its hash; a run of equal hashes is compared in full
+	for(std::size_t first = 0; first < _name_index.size(); first++)
+	{
+		for(std::size_t other = first + 1;
+			other < _name_index.size() && _name_index[other].first == _name_index[first].first; other++
+		)
+		{
+			std::string station_name = name(_name_index[first].second);
+			if(station_name == name(_name_index[other].second))
+			{
+				throw std::runtime_error("Two stations are named '" + station_name + "'");
+			}
+		}
+	}
+}
+
+
+std::size_t BatchJob::find(const std::string& station_name) const
+/*
+The station named `station_name`, or `_stations.size()` if there is none. `index_names()` must have run.
+*/
+{
+	std::uint64_t name_hash = hash(station_name);
+	for(std::vector<std::pair<std::uint64_t, std::size_t>>::const_iterator entry = std::lower_bound(
+		_name_index.begin(), _name_index.end(), std::make_pair(name_hash, static_cast<std::size_t>(0)));
+		entry != _name_index.end() && entry->first == name_hash; entry++
+	)
+	{
+		if(name(entry->second) == station_name)
+		{
+			return entry->second;
+		}
+	}
+	return _stations.size();
+}
+
+
+void BatchJob::read(const std::string& path)
+/*
+A job file holds the same settings as the flags, one `key value` per line, e.g.
+```
+|# Nightly stations
+|start    2019-06-01
+|end      2019-06-08
+|step     30
+|format   binary
+|station  45.0, -120.0, 312.5, P123
+|station  -33.9, 18.4, 0, CPT1
+```
+*/
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("Unable to open job file " + path);
+	}
+
+	std::string line;
+	for(unsigned int line_number = 1; std::getline(file, line); line_number++)
+	{
+		std::size_t comment = line.find('#');
+		if(comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+		std::size_t key_start = line.find_first_not_of(" \t\r");
+		if(key_start == std::string::npos)
+		{
+			continue;  // Blank line
+		}
+		std::size_t key_end = line.find_first_of(" \t", key_start);
+		std::size_t value_start = key_end == std::string::npos ? key_end : line.find_first_not_of(" \t", key_end);
+		std::size_t value_end = line.find_last_not_of(" \t\r");
+		std::string key = line.substr(key_start, key_end == std::string::npos ? key_end : key_end - key_start);
+		if(value_start == std::string::npos)
+		{
+			throw std::runtime_error("Missing value for '" + key + "' on line " + std::to_string(line_number) + " of "
+				+ path);
+		}
+		if(key == "job")
+		{
+			throw std::runtime_error("Job files cannot include other job files (line " + std::to_string(line_number)
+				+ " of " + path + ")");
+		}
+
+		try
+		{
+			set(key, line.substr(value_start, value_end + 1 - value_start));
+		}
+		catch(std::runtime_error& error)
+		{
+			throw std::runtime_error(std::string(error.what()) + " (line " + std::to_string(line_number) + " of " + path
+				+ ")");
+		}
+	}
+}
+
+
+void BatchJob::epoch(const std::string& value, unsigned int& modified_julian_date, double& seconds)
+/*
+`YYYY-MM-DD[Thh:mm[:ss]]` in UTC, within the years solid.f accepts (1901–2099). The date converts with `civmjd`; the
+ time of day is kept in seconds, since `Datetime` holds whole seconds only.
+*/
+{
+	int year = 0, month = 0, day = 0, hour = 0, minute = 0, consumed = 0;
+	double second = 0.0;
+	const char* text = value.c_str();
+	bool valid = std::sscanf(text, "%4d-%2d-%2d%n", &year, &month, &day, &consumed) == 3;
+	if(valid && text[consumed] == 'T')
+	{
+		int time_consumed = 0;
+		valid = std::sscanf(text + consumed, "T%2d:%2d%n", &hour, &minute, &time_consumed) == 2;
+		consumed += time_consumed;
+		if(valid && text[consumed] == ':')
+		{
+			valid = std::sscanf(text + consumed, ":%lf%n", &second, &time_consumed) == 1;
+			consumed += time_consumed;
+		}
+	}
+	if(!valid || static_cast<std::size_t>(consumed) != value.size())
+	{
+		throw std::runtime_error("Expected a UTC time YYYY-MM-DD[Thh:mm[:ss]], not '" + value + "'");
+	}
+
+	const int month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	bool leap_year = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+	if(year < 1901 || year > 2099 || month < 1 || month > 12 || day < 1
+	  || day > month_days[month - 1] + (month == Datetime::FEBRUARY && leap_year) || hour > 23 || minute > 59
+	  || !(0.0 <= second && second < 60.0)
+	)
+	{
+		throw std::runtime_error("UTC time out of range (years 1901–2099): '" + value + "'");
+	}
+
+	JulianDate julian_date = Datetime(year, month, day);
+	modified_julian_date = julian_date.modified_julian_date();
+	seconds = hour * 3600.0 + minute * 60.0 + second;
+}
+
+
+std::size_t BatchJob::count(unsigned int start_modified_julian_date, double start_seconds,
+	unsigned int end_modified_julian_date, double end_seconds, double step_seconds
+)
+/*
+solid.f [LN 77–78]
+```
+|      tdel2=1.d0/60.d0/24.d0                           !*** 1 minute steps
+|      do iloop=0,60*24
+```
+Samples from start through end, both included, so a day at the default step is 60 × 24 + 1 samples.
+*/
+{
+	double span_seconds = (static_cast<double>(end_modified_julian_date) - start_modified_julian_date) * 86400.0
+		+ end_seconds - start_seconds;
+	if(span_seconds < 0.0)
+	{
+		throw std::runtime_error("The end of a time range is before its start");
+	}
+	// The tolerance keeps an end that is a whole number of steps away despite rounding
+	return static_cast<std::size_t>(std::floor(span_seconds / step_seconds + 1e-9)) + 1;
+}
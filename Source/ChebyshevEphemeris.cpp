@@ -0,0 +1,263 @@
+
+
+#include "ChebyshevEphemeris.hpp"
+
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+
+#include "EphemerisKernels.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+
+
+const double ChebyshevEphemeris::SOLAR_SEGMENT_DAYS = 8.0;
+const double ChebyshevEphemeris::LUNAR_SEGMENT_DAYS = 1.0;
+const unsigned int ChebyshevEphemeris::SOLAR_DEGREE = 8;
+const unsigned int ChebyshevEphemeris::LUNAR_DEGREE = 11;
+
+/*
+The tidal displacement scales with the cube of the inverse distance to the body, so a relative position error of ε
+ changes it by about 3ε. Against displacements of a few decimeters, these keep the fit far below a micrometer.
+*/
+const double ChebyshevEphemeris::SOLAR_TOLERANCE = 10.0;
+const double ChebyshevEphemeris::LUNAR_TOLERANCE = 0.1;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+ChebyshevEphemeris::ChebyshevEphemeris(unsigned int first_modified_julian_date, unsigned int days)
+/*
+Fits segments covering the UTC days [`first_modified_julian_date`, `first_modified_julian_date` + `days`]. A day of
+ margin is added on either side, since the series are evaluated in TT rather than UTC.
+*/
+{
+	/*
+	solid.f [LN 916–917]
+	```
+	|      tjdtt = mjd+fmjdtt+2400000.5d0              !*** Julian Date, TT
+	|      t     = (tjdtt - 2451545.d0)/36525.d0       !*** julian centuries, TT
+	```
+	*/
+	double start = (first_modified_julian_date - 1.0 + 2400000.5 - 2451545.0) / 36525.0;
+	double span_days = days + 2.0;
+
+	_solar.start = start;
+	_solar.length = SOLAR_SEGMENT_DAYS / 36525.0;
+	_solar.count = static_cast<unsigned int>(std::ceil(span_days / SOLAR_SEGMENT_DAYS));
+	_solar.degree = SOLAR_DEGREE;
+	fit(_solar, EphemerisKernels::sun_inertial_coordinates, Geolocation::sun_inertial_coordinates);
+
+	_lunar.start = start;
+	_lunar.length = LUNAR_SEGMENT_DAYS / 36525.0;
+	_lunar.count = static_cast<unsigned int>(std::ceil(span_days / LUNAR_SEGMENT_DAYS));
+	_lunar.degree = LUNAR_DEGREE;
+	fit(_lunar, EphemerisKernels::moon_inertial_coordinates, Geolocation::moon_inertial_coordinates);
+
+	if(SOLAR_TOLERANCE < _solar.fit_error)
+	{
+		throw std::runtime_error("Solar Chebyshev fit error of " + std::to_string(_solar.fit_error) + " m exceeds "
+			+ std::to_string(SOLAR_TOLERANCE) + " m");
+	}
+
+	if(LUNAR_TOLERANCE < _lunar.fit_error)
+	{
+		throw std::runtime_error("Lunar Chebyshev fit error of " + std::to_string(_lunar.fit_error) + " m exceeds "
+			+ std::to_string(LUNAR_TOLERANCE) + " m");
+	}
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+Coordinate<double> ChebyshevEphemeris::sun_coordinates(unsigned int initial_modified_julian_date,
+	JulianDate& julian_date
+) const
+/*
+Equivalent of `Geolocation::sun_coordinates`.
+*/
+{
+	double terrestrial_time = julian_date.JulianCenturies(initial_modified_julian_date);
+	Coordinate<double> radius_solar_coordinates = sun_inertial_coordinates(terrestrial_time);
+	return radius_solar_coordinates.rotate3(julian_date.GreenwichHourAngleRadians());
+}
+
+
+Coordinate<double> ChebyshevEphemeris::moon_coordinates(unsigned int initial_modified_julian_date,
+	JulianDate& julian_date
+) const
+/*
+Equivalent of `Geolocation::moon_coordinates`.
+*/
+{
+	double terrestrial_time = julian_date.JulianCenturies(initial_modified_julian_date);
+	Coordinate<double> radius_lunar_coordinates = moon_inertial_coordinates(terrestrial_time);
+	return radius_lunar_coordinates.rotate3(julian_date.GreenwichHourAngleRadians());
+}
+
+
+Coordinate<double> ChebyshevEphemeris::sun_coordinates(const EpochContext& epoch_context) const
+/*
+Equivalent of `Geolocation::sun_coordinates(epoch_context)`.
+*/
+{
+	return sun_inertial_coordinates(epoch_context.julian_centuries)
+		.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+}
+
+
+Coordinate<double> ChebyshevEphemeris::moon_coordinates(const EpochContext& epoch_context) const
+/*
+Equivalent of `Geolocation::moon_coordinates(epoch_context, lunar_series)`.
+*/
+{
+	return moon_inertial_coordinates(epoch_context.julian_centuries)
+		.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+}
+
+
+Coordinate<double> ChebyshevEphemeris::sun_inertial_coordinates(double terrestrial_time) const
+/*
+Epochs outside of the fitted span fall back to the direct series.
+*/
+{
+	Coordinate<double> coordinate;
+	if(!evaluate(_solar, terrestrial_time, coordinate))
+	{
+		return Geolocation::sun_inertial_coordinates(terrestrial_time);
+	}
+	return coordinate;
+}
+
+
+Coordinate<double> ChebyshevEphemeris::moon_inertial_coordinates(double terrestrial_time) const
+/*
+Epochs outside of the fitted span fall back to the direct series.
+*/
+{
+	Coordinate<double> coordinate;
+	if(!evaluate(_lunar, terrestrial_time, coordinate))
+	{
+		return Geolocation::moon_inertial_coordinates(terrestrial_time);
+	}
+	return coordinate;
+}
+
+
+double ChebyshevEphemeris::solar_fit_error() const
+{
+	return _solar.fit_error;
+}
+
+
+double ChebyshevEphemeris::lunar_fit_error() const
+{
+	return _lunar.fit_error;
+}
+
+
+void ChebyshevEphemeris::fit(Segments& segments, Kernel kernel, Series series)
+/*
+Interpolates `kernel` at the degree + 1 Chebyshev nodes of the first kind in each segment, so that
+ c_j = 2 / (n + 1) · Σ_k f(x_k) · cos(j · (k + ½) · π / (n + 1)). The first coefficient is stored halved, so that
+ evaluation is a plain sum. The fit is then compared against the direct `series`, of which `kernel` is the vectorized
+ form, at degree + 1 evenly spaced points. The difference there is dominated by the kernels' rounding rather than the
+ interpolation, so a denser check finds much the same error at several times the cost of the direct series.
+*/
+{
+	unsigned int nodes = segments.degree + 1;
+	segments.coefficients.assign(segments.count * 3 * nodes, 0.0);
+	segments.fit_error = 0.0;
+
+	// basis[j][node] = T_j(x_node) = cos(j · (node + ½) · π / (n + 1))
+	std::vector<double> basis(nodes * nodes), times(nodes), values[3];
+	for(unsigned int j = 0; j < nodes; j++)
+	{
+		for(unsigned int node = 0; node < nodes; node++)
+		{
+			basis[j * nodes + node] = cos(Geolocation::PI * j * (node + 0.5) / nodes);
+		}
+	}
+	for(unsigned int component = 0; component < 3; component++)
+	{
+		values[component].resize(nodes);
+	}
+
+	for(unsigned int segment = 0; segment < segments.count; segment++)
+	{
+		double segment_start = segments.start + segment * segments.length;
+		for(unsigned int node = 0; node < nodes; node++)
+		{
+			times[node] = segment_start + (basis[nodes + node] + 1.0) / 2.0 * segments.length;
+		}
+		kernel(times.data(), nodes, values[X].data(), values[Y].data(), values[Z].data());
+
+		double* coefficients = &segments.coefficients[segment * 3 * nodes];
+		for(unsigned int component = 0; component < 3; component++)
+		{
+			for(unsigned int j = 0; j < nodes; j++)
+			{
+				double sum = 0.0;
+				for(unsigned int node = 0; node < nodes; node++)
+				{
+					sum += values[component][node] * basis[j * nodes + node];
+				}
+				coefficients[component * nodes + j] = sum * 2.0 / nodes * (j == 0 ? 0.5 : 1.0);
+			}
+		}
+
+		for(unsigned int check = 0; check < nodes; check++)
+		{
+			double time = segment_start + (check + 0.5) / nodes * segments.length;
+			Coordinate<double> fitted;
+			evaluate(segments, time, fitted);
+			Coordinate<double> direct = series(time);
+			Coordinate<double> difference(fitted[X] - direct[X], fitted[Y] - direct[Y], fitted[Z] - direct[Z]);
+			if(segments.fit_error < difference.distance())
+			{
+				segments.fit_error = difference.distance();
+			}
+		}
+	}
+}
+
+
+bool ChebyshevEphemeris::evaluate(const Segments& segments, double terrestrial_time, Coordinate<double>& coordinate)
+/*
+Clenshaw recurrence: b_k = c_k + 2x · b_(k+1) - b_(k+2), f(x) = c_0 + x · b_1 - b_2 (c_0 is stored halved), for x, y &
+ z in one loop so that their three chains overlap. Returns false when `terrestrial_time` is outside of the fitted
+ segments.
+*/
+{
+	double offset = (terrestrial_time - segments.start) / segments.length;
+	if(offset < 0.0 || segments.count <= offset)
+	{
+		return false;
+	}
+
+	unsigned int segment = static_cast<unsigned int>(offset);
+	unsigned int nodes = segments.degree + 1;
+	double two_x = 4.0 * (offset - segment) - 2.0;
+	const double* c_x = &segments.coefficients[segment * 3 * nodes];
+	const double* c_y = c_x + nodes;
+	const double* c_z = c_y + nodes;
+	double b1_x = 0.0, b1_y = 0.0, b1_z = 0.0, b2_x = 0.0, b2_y = 0.0, b2_z = 0.0;
+	for(unsigned int k = segments.degree; k > 0; k--)
+	{
+		double b0_x = c_x[k] + two_x * b1_x - b2_x;
+		double b0_y = c_y[k] + two_x * b1_y - b2_y;
+		double b0_z = c_z[k] + two_x * b1_z - b2_z;
+		b2_x = b1_x;
+		b2_y = b1_y;
+		b2_z = b1_z;
+		b1_x = b0_x;
+		b1_y = b0_y;
+		b1_z = b0_z;
+	}
+	coordinate = Coordinate<double>(c_x[0] + 0.5 * two_x * b1_x - b2_x, c_y[0] + 0.5 * two_x * b1_y - b2_y,
+		c_z[0] + 0.5 * two_x * b1_z - b2_z);
+	return true;
+}
@@ -114,3 +114,21 @@ sec — _second
 
 	return JulianDate(modified_julian_date, fractional_modified_julian_date);
 }
+
+
+unsigned int Datetime::year()
+{
+	return _year;
+}
+
+
+unsigned int Datetime::month()
+{
+	return _month;
+}
+
+
+unsigned int Datetime::day()
+{
+	return _day;
+}
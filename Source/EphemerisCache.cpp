@@ -0,0 +1,144 @@
+
+
+#include "EphemerisCache.hpp"
+
+
+#include <cstring>
+
+
+#include "JulianDate.hpp"
+
+
+const std::size_t EphemerisCache::LOCKS = 64;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+EphemerisCache::EphemerisCache(std::size_t capacity/*=1024*/,
+	Geolocation::LunarSeries lunar_series/*=Geolocation::LunarSeries::DIRECT*/
+)
+: _lunar_series{lunar_series}, _locks{new std::mutex[LOCKS]}, _hits{0}, _misses{0}
+{
+	std::size_t size = 1;
+	while(size < capacity)
+	{
+		size <<= 1;
+	}
+
+	_entries.resize(size);
+	clear();
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+bool EphemerisCache::holds(Entry& entry, unsigned int initial_modified_julian_date, JulianDate& julian_date)
+{
+	return entry.modified_julian_date == julian_date.modified_julian_date()
+	  && entry.fractional_modified_julian_date == julian_date.fractional_modified_julian_date()
+	  && entry.initial_modified_julian_date == initial_modified_julian_date;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+Coordinate<double> EphemerisCache::sun_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date)
+{
+	return coordinates(initial_modified_julian_date, julian_date, false);
+}
+
+
+Coordinate<double> EphemerisCache::moon_coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date)
+{
+	return coordinates(initial_modified_julian_date, julian_date, true);
+}
+
+
+std::size_t EphemerisCache::capacity()
+{
+	return _entries.size();
+}
+
+
+unsigned long long EphemerisCache::hits()
+{
+	return _hits.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long EphemerisCache::misses()
+{
+	return _misses.load(std::memory_order_relaxed);
+}
+
+
+void EphemerisCache::clear()
+{
+	for(std::size_t index = 0; index < _entries.size(); index++)
+	{
+		std::lock_guard<std::mutex> lock(_locks[index % LOCKS]);
+		_entries[index].has_sun = false;
+		_entries[index].has_moon = false;
+	}
+	_hits.store(0, std::memory_order_relaxed);
+	_misses.store(0, std::memory_order_relaxed);
+}
+
+
+Coordinate<double> EphemerisCache::coordinates(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+	bool lunar
+)
+/*
+The sun's (or, if `lunar`, the moon's) position at the epoch from its slot, else evaluated outside the slot's lock &
+ stored. If the slot holds another epoch by then, it is taken over (the previous epoch is evicted).
+*/
+{
+	std::size_t index = slot(initial_modified_julian_date, julian_date);
+	Entry& entry = _entries[index];
+	std::mutex& mutex = _locks[index % LOCKS];
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(holds(entry, initial_modified_julian_date, julian_date) && (lunar ? entry.has_moon : entry.has_sun))
+		{
+			_hits.fetch_add(1, std::memory_order_relaxed);
+			return lunar ? entry.lunar_coordinate : entry.solar_coordinate;
+		}
+	}
+
+	_misses.fetch_add(1, std::memory_order_relaxed);
+	Coordinate<double> coordinate = lunar
+	  ? Geolocation::moon_coordinates(initial_modified_julian_date, julian_date, _lunar_series)
+	  : Geolocation::sun_coordinates(initial_modified_julian_date, julian_date);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!holds(entry, initial_modified_julian_date, julian_date))
+	{
+		entry.has_sun = false;
+		entry.has_moon = false;
+		entry.initial_modified_julian_date = initial_modified_julian_date;
+		entry.modified_julian_date = julian_date.modified_julian_date();
+		entry.fractional_modified_julian_date = julian_date.fractional_modified_julian_date();
+	}
+	(lunar ? entry.lunar_coordinate : entry.solar_coordinate) = coordinate;
+	(lunar ? entry.has_moon : entry.has_sun) = true;
+	return coordinate;
+}
+
+
+std::size_t EphemerisCache::slot(unsigned int initial_modified_julian_date, JulianDate& julian_date)
+/*
+The index of the epoch's slot.
+*/
+{
+	unsigned int modified_julian_date = julian_date.modified_julian_date();
+	double fractional_modified_julian_date = julian_date.fractional_modified_julian_date();
+
+	std::uint64_t fraction_bits;
+	std::memcpy(&fraction_bits, &fractional_modified_julian_date, sizeof(fraction_bits));
+
+	// Fibonacci hashing of the key; the high bits are the best mixed
+	std::uint64_t hash = (fraction_bits ^ ((std::uint64_t)modified_julian_date << 32) ^ initial_modified_julian_date)
+		* 0x9E3779B97F4A7C15ull;
+	return (hash >> 32) & (_entries.size() - 1);
+}
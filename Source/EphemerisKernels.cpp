@@ -0,0 +1,149 @@
+
+
+#include "EphemerisKernels.hpp"
+
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+#include "Geolocation.hpp"
+
+
+// ————————————————————————————————————————————————————— LANES  ————————————————————————————————————————————————————— //
+/*
+Each `*Lanes` type wraps one register of doubles with the handful of operations the kernels need, so that the series
+ (EphemerisKernelSeries.hpp) are written once & compiled for every width. The AVX2 & AVX-512 ones are in their own
+ translation units, which alone are compiled for those instruction sets.
+*/
+
+struct ScalarLanes
+{
+	typedef bool Mask;
+	static const unsigned int WIDTH = 1;
+
+	double value;
+
+	static ScalarLanes broadcast(double value) { return ScalarLanes{value}; }
+	static ScalarLanes load(const double* source) { return ScalarLanes{*source}; }
+	void store(double* destination) const { *destination = value; }
+
+	static ScalarLanes round(ScalarLanes lanes) { return ScalarLanes{std::nearbyint(lanes.value)}; }
+	static Mask equal(ScalarLanes left, ScalarLanes right) { return left.value == right.value; }
+	static Mask either(Mask left, Mask right) { return left || right; }
+	static ScalarLanes select(Mask mask, ScalarLanes when_true, ScalarLanes when_false)
+	{
+		return mask ? when_true : when_false;
+	}
+
+	friend ScalarLanes operator+(ScalarLanes left, ScalarLanes right) { return ScalarLanes{left.value + right.value}; }
+	friend ScalarLanes operator-(ScalarLanes left, ScalarLanes right) { return ScalarLanes{left.value - right.value}; }
+	friend ScalarLanes operator*(ScalarLanes left, ScalarLanes right) { return ScalarLanes{left.value * right.value}; }
+	friend ScalarLanes operator-(ScalarLanes lanes) { return ScalarLanes{-lanes.value}; }
+};
+
+
+#include "EphemerisKernelSeries.hpp"
+
+
+const EphemerisKernels::Implementation EphemerisKernels::SCALAR = {"scalar", ScalarLanes::WIDTH,
+	run_kernel<ScalarLanes, sun_kernel<ScalarLanes>>, run_kernel<ScalarLanes, moon_kernel<ScalarLanes>>};
+
+
+static double deviation(void (*kernel)(const double*, std::size_t, double*, double*, double*),
+	Coordinate<double> (*series)(double), const double* terrestrial_time, std::size_t count
+)
+{
+	std::vector<double> x(count), y(count), z(count);
+	kernel(terrestrial_time, count, x.data(), y.data(), z.data());
+
+	double maximum = 0.0;
+	for(std::size_t index = 0; index < count; index++)
+	{
+		Coordinate<double> reference = series(terrestrial_time[index]);
+		Coordinate<double> difference(x[index] - reference[X], y[index] - reference[Y], z[index] - reference[Z]);
+		if(maximum < difference.distance())
+		{
+			maximum = difference.distance();
+		}
+	}
+	return maximum;
+}
+
+
+// ————————————————————————————————————————————————————— PUBLIC ————————————————————————————————————————————————————— //
+
+unsigned int EphemerisKernels::lanes()
+{
+	return implementation().lanes;
+}
+
+
+const char* EphemerisKernels::instruction_set()
+{
+	return implementation().instruction_set;
+}
+
+
+void EphemerisKernels::sun_inertial_coordinates(const double* terrestrial_time, std::size_t count, double* x,
+	double* y, double* z
+)
+{
+	implementation().sun(terrestrial_time, count, x, y, z);
+}
+
+
+void EphemerisKernels::moon_inertial_coordinates(const double* terrestrial_time, std::size_t count, double* x,
+	double* y, double* z
+)
+{
+	implementation().moon(terrestrial_time, count, x, y, z);
+}
+
+
+double EphemerisKernels::sun_deviation(const double* terrestrial_time, std::size_t count)
+{
+	return deviation(sun_inertial_coordinates, Geolocation::sun_inertial_coordinates, terrestrial_time, count);
+}
+
+
+double EphemerisKernels::moon_deviation(const double* terrestrial_time, std::size_t count)
+{
+	return deviation(moon_inertial_coordinates, Geolocation::moon_inertial_coordinates, terrestrial_time, count);
+}
+
+
+// ———————————————————————————————————————————————————— PRIVATE  ———————————————————————————————————————————————————— //
+
+const EphemerisKernels::Implementation& EphemerisKernels::implementation()
+/*
+The widest kernels this processor (& its operating system, which must save the wider registers) supports, chosen once.
+ `SOLID_EARTH_TIDE_KERNELS=scalar|AVX2` narrows the choice, so that each can be checked on a machine with all three.
+*/
+{
+	static const Implementation& chosen = []() -> const Implementation&
+	{
+		const char* limit = std::getenv("SOLID_EARTH_TIDE_KERNELS");
+		std::string narrowest = limit ? limit : "";
+		if(narrowest == SCALAR.instruction_set)
+		{
+			return SCALAR;
+		}
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_cpu_init();
+		if(narrowest != AVX2.instruction_set && __builtin_cpu_supports("avx512f"))
+		{
+			return AVX512;
+		}
+		if(__builtin_cpu_supports("avx2"))
+		{
+			return AVX2;
+		}
+#endif
+		return SCALAR;
+	}();
+	return chosen;
+}
@@ -0,0 +1,62 @@
+
+
+#include "EphemerisKernels.hpp"
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+
+#include <cmath>
+#include <cstddef>
+
+
+#include "Geolocation.hpp"
+
+
+/*
+Only what follows is compiled for AVX2 (the headers above come first, so that nothing the rest of the library shares
+ is); `EphemerisKernels::implementation()` calls it only on processors that support AVX2.
+*/
+#pragma GCC target("avx2")
+#include <immintrin.h>
+
+
+struct AVX2Lanes
+{
+	typedef __m256d Mask;
+	static const unsigned int WIDTH = 4;
+
+	__m256d value;
+
+	static AVX2Lanes broadcast(double value) { return AVX2Lanes{_mm256_set1_pd(value)}; }
+	static AVX2Lanes load(const double* source) { return AVX2Lanes{_mm256_loadu_pd(source)}; }
+	void store(double* destination) const { _mm256_storeu_pd(destination, value); }
+
+	static AVX2Lanes round(AVX2Lanes lanes)
+	{
+		return AVX2Lanes{_mm256_round_pd(lanes.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+	}
+	static Mask equal(AVX2Lanes left, AVX2Lanes right) { return _mm256_cmp_pd(left.value, right.value, _CMP_EQ_OQ); }
+	static Mask either(Mask left, Mask right) { return _mm256_or_pd(left, right); }
+	static AVX2Lanes select(Mask mask, AVX2Lanes when_true, AVX2Lanes when_false)
+	{
+		return AVX2Lanes{_mm256_blendv_pd(when_false.value, when_true.value, mask)};
+	}
+};
+
+
+// Outside the struct, because GCC does not apply the target to friends defined in it
+inline AVX2Lanes operator+(AVX2Lanes left, AVX2Lanes right) { return AVX2Lanes{_mm256_add_pd(left.value, right.value)}; }
+inline AVX2Lanes operator-(AVX2Lanes left, AVX2Lanes right) { return AVX2Lanes{_mm256_sub_pd(left.value, right.value)}; }
+inline AVX2Lanes operator*(AVX2Lanes left, AVX2Lanes right) { return AVX2Lanes{_mm256_mul_pd(left.value, right.value)}; }
+inline AVX2Lanes operator-(AVX2Lanes lanes) { return AVX2Lanes{_mm256_sub_pd(_mm256_setzero_pd(), lanes.value)}; }
+
+
+#include "EphemerisKernelSeries.hpp"
+
+
+const EphemerisKernels::Implementation EphemerisKernels::AVX2 = {"AVX2", AVX2Lanes::WIDTH,
+	run_kernel<AVX2Lanes, sun_kernel<AVX2Lanes>>, run_kernel<AVX2Lanes, moon_kernel<AVX2Lanes>>};
+
+
+#endif
@@ -0,0 +1,79 @@
+
+
+#include "EphemerisKernels.hpp"
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+
+#include <cmath>
+#include <cstddef>
+
+
+#include "Geolocation.hpp"
+
+
+/*
+Only what follows is compiled for AVX-512 (the headers above come first, so that nothing the rest of the library shares
+ is); `EphemerisKernels::implementation()` calls it only on processors that support AVX-512.
+*/
+#pragma GCC target("avx512f")
+#include <immintrin.h>
+
+
+struct AVX512Lanes
+{
+	typedef __mmask8 Mask;
+	static const unsigned int WIDTH = 8;
+
+	__m512d value;
+
+	static AVX512Lanes broadcast(double value) { return AVX512Lanes{_mm512_set1_pd(value)}; }
+	static AVX512Lanes load(const double* source) { return AVX512Lanes{_mm512_loadu_pd(source)}; }
+	void store(double* destination) const { _mm512_storeu_pd(destination, value); }
+
+	static AVX512Lanes round(AVX512Lanes lanes)
+	{
+		// The masked form, because GCC 12 warns about the unmasked one's undefined pass-through operand
+		return AVX512Lanes{_mm512_mask_roundscale_pd(lanes.value, 0xFF, lanes.value,
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+	}
+	static Mask equal(AVX512Lanes left, AVX512Lanes right)
+	{
+		return _mm512_cmp_pd_mask(left.value, right.value, _CMP_EQ_OQ);
+	}
+	static Mask either(Mask left, Mask right) { return left | right; }
+	static AVX512Lanes select(Mask mask, AVX512Lanes when_true, AVX512Lanes when_false)
+	{
+		return AVX512Lanes{_mm512_mask_blend_pd(mask, when_false.value, when_true.value)};
+	}
+};
+
+
+// Outside the struct, because GCC does not apply the target to friends defined in it
+inline AVX512Lanes operator+(AVX512Lanes left, AVX512Lanes right)
+{
+	return AVX512Lanes{_mm512_add_pd(left.value, right.value)};
+}
+inline AVX512Lanes operator-(AVX512Lanes left, AVX512Lanes right)
+{
+	return AVX512Lanes{_mm512_sub_pd(left.value, right.value)};
+}
+inline AVX512Lanes operator*(AVX512Lanes left, AVX512Lanes right)
+{
+	return AVX512Lanes{_mm512_mul_pd(left.value, right.value)};
+}
+inline AVX512Lanes operator-(AVX512Lanes lanes)
+{
+	return AVX512Lanes{_mm512_sub_pd(_mm512_setzero_pd(), lanes.value)};
+}
+
+
+#include "EphemerisKernelSeries.hpp"
+
+
+const EphemerisKernels::Implementation EphemerisKernels::AVX512 = {"AVX-512", AVX512Lanes::WIDTH,
+	run_kernel<AVX512Lanes, sun_kernel<AVX512Lanes>>, run_kernel<AVX512Lanes, moon_kernel<AVX512Lanes>>};
+
+
+#endif
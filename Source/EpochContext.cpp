@@ -0,0 +1,116 @@
+
+
+#include "EpochContext.hpp"
+
+
+#include <cmath>
+
+
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+#include "LeapSecondTable.hpp"
+
+
+const double EpochContext::PROBE_DAYS = 0.4;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+EpochContext::EpochContext(unsigned int initial_modified_julian_date, JulianDate& julian_date)
+/*
+solid.f [LN 168–175]
+```
+|      leapflag=lflag
+|      tsecutc =fmjd*86400.d0                       !*** UTC time (sec of day)
+|      tsectt  =utc2ttt(tsecutc)                    !*** TT  time (sec of day)
+|      fmjdtt  =tsectt/86400.d0                     !*** TT  time (fract. day)
+|      lflag   = leapflag
+|
+|      dmjdtt=mjd+fmjdtt                           !*** float MJD in TT
+```
+The same conversions as `JulianDate::TerrestrialTime()`, `JulianDate::JulianCenturies()` &
+ `JulianDate::GreenwichHourAngleRadians()`, evaluated once.
+*/
+: modified_julian_date{julian_date.modified_julian_date()},
+  fractional_modified_julian_date{julian_date.fractional_modified_julian_date()},
+  time_seconds_UTC{fractional_modified_julian_date * 86400.0},
+  time_seconds_TAI{julian_date.UTC_to_TAI(initial_modified_julian_date)},
+  terrestrial_time_days{modified_julian_date + (time_seconds_TAI + 32.184) / 86400.0},
+  leap_second_flag{!LeapSecondTable::current().contains(static_cast<int>(initial_modified_julian_date)
+	+ static_cast<int>(std::floor(time_seconds_UTC / 86400.0)))},
+  fundamental_arguments{terrestrial_time_days},
+  julian_centuries{fundamental_arguments.julian_centuries},
+  terrestrial_time_hours{fundamental_arguments.terrestrial_time_hours},
+  greenwich_hour_angle{julian_date.GreenwichHourAngleRadians()},
+  sin_greenwich_hour_angle{std::sin(greenwich_hour_angle)},
+  cos_greenwich_hour_angle{std::cos(greenwich_hour_angle)}
+{}
+
+
+EpochContext::EpochContext(JulianDate& julian_date, const EpochContext& previous, const Step& step)
+/*
+The context of `julian_date`, advanced from `previous` by `step` (see `UniformEpochs`). `previous` must be in the same
+ UTC day, so that TAI−UTC & the leap second flag carry over; the times are evaluated directly and the angles are
+ rotated by their steps rather than by calling `sin`/`cos`. The hour angle is kept in [0, 2π) as a direct evaluation
+ leaves it.
+*/
+: modified_julian_date{julian_date.modified_julian_date()},
+  fractional_modified_julian_date{julian_date.fractional_modified_julian_date()},
+  time_seconds_UTC{fractional_modified_julian_date * 86400.0},
+  time_seconds_TAI{time_seconds_UTC + (previous.time_seconds_TAI - previous.time_seconds_UTC)},
+  terrestrial_time_days{modified_julian_date + (time_seconds_TAI + 32.184) / 86400.0},
+  leap_second_flag{previous.leap_second_flag},
+  fundamental_arguments{terrestrial_time_days, previous.fundamental_arguments, step.fundamental_arguments},
+  julian_centuries{fundamental_arguments.julian_centuries},
+  terrestrial_time_hours{fundamental_arguments.terrestrial_time_hours},
+  greenwich_hour_angle{advance(previous.greenwich_hour_angle, step.greenwich_hour_angle)},
+  sin_greenwich_hour_angle{previous.sin_greenwich_hour_angle * step.cos_greenwich_hour_angle
+	+ previous.cos_greenwich_hour_angle * step.sin_greenwich_hour_angle},
+  cos_greenwich_hour_angle{previous.cos_greenwich_hour_angle * step.cos_greenwich_hour_angle
+	- previous.sin_greenwich_hour_angle * step.sin_greenwich_hour_angle}
+{}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+EpochContext::Step EpochContext::step(const EpochContext& from, double step_seconds)
+/*
+The change of every angle over `step_seconds` after `from`. The angles are linear within the UTC day, so their rates are
+ measured against a second epoch `PROBE_DAYS` away in the same day: differencing two epochs one step apart would scale
+ their rounding up by the number of steps advanced. No angle turns by 180° in `PROBE_DAYS`, so each difference is the
+ short way round.
+*/
+{
+	double probe_days = from.fractional_modified_julian_date < 0.5 ? PROBE_DAYS : -PROBE_DAYS;
+	JulianDate probe_date(from.modified_julian_date, from.fractional_modified_julian_date + probe_days);
+	EpochContext probe(from.modified_julian_date, probe_date);
+	double fraction = step_seconds / 86400.0 / probe_days;
+
+	// In [-π, π), so that hour angles reduced on either side of 2π still give the short way between them
+	double greenwich_hour_angle = probe.greenwich_hour_angle - from.greenwich_hour_angle;
+	greenwich_hour_angle -= 2.0 * Geolocation::PI * std::floor(greenwich_hour_angle / (2.0 * Geolocation::PI) + 0.5);
+	greenwich_hour_angle *= fraction;
+
+	return Step{
+		greenwich_hour_angle, std::sin(greenwich_hour_angle), std::cos(greenwich_hour_angle),
+		FundamentalArguments::step(from.fundamental_arguments, probe.fundamental_arguments, fraction)
+	};
+}
+
+
+double EpochContext::advance(double greenwich_hour_angle, double step)
+/*
+`greenwich_hour_angle` + `step` (less than a turn either way), reduced to [0, 2π).
+*/
+{
+	double advanced = greenwich_hour_angle + step;
+	if(advanced >= 2.0 * Geolocation::PI)
+	{
+		advanced -= 2.0 * Geolocation::PI;
+	}
+	else if(advanced < 0.0)
+	{
+		advanced += 2.0 * Geolocation::PI;
+	}
+	return advanced;
+}
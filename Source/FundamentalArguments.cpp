@@ -0,0 +1,213 @@
+
+
+#include "FundamentalArguments.hpp"
+
+
+#include <cmath>
+
+
+#include "Geolocation.hpp"
+
+
+const int FundamentalArguments::MULTIPLE;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+FundamentalArguments::FundamentalArguments(double terrestrial_time_days)
+/*
+solid.f [LN 177–178]
+```
+|      t=(dmjdtt-51544.d0)/36525.d0                !*** days to centuries, TT
+|      fhr=(dmjdtt-int(dmjdtt))*24.d0              !*** hours in the day, TT
+```
+solid.f [LN 449–463]
+```
+|      s=218.31664563d0+481267.88194d0*t-0.0014663889d0*t*t
+|     * +0.00000185139d0*t**3
+|      tau=fhr*15.d0+280.4606184d0+36000.7700536d0*t+0.00038793d0*t*t
+|     * -0.0000000258d0*t**3-s
+|      pr=1.396971278*t+0.000308889*t*t+0.000000021*t**3
+|     * +0.000000007*t**4
+|      s=s+pr
+|      h=280.46645d0+36000.7697489d0*t+0.00030322222d0*t*t
+|     * +0.000000020*t**3-0.00000000654*t**4
+|      p=83.35324312d0+4069.01363525d0*t-0.01032172222d0*t*t
+|     * -0.0000124991d0*t**3+0.00000005263d0*t**4
+|      zns=234.95544499d0 +1934.13626197d0*t-0.00207561111d0*t*t
+|     * -0.00000213944d0*t**3+0.00000001650d0*t**4
+|      ps=282.93734098d0+1.71945766667d0*t+0.00045688889d0*t*t
+|     * -0.00000001778d0*t**3-0.00000000334d0*t**4
+```
+solid.f [LN 758–762]
+```
+|      el0=218.31617d0 + 481267.88088d0*t -1.3972*t
+|      el =134.96292d0 + 477198.86753d0*t
+|      elp=357.52543d0 +  35999.04944d0*t
+|      f  = 93.27283d0 + 483202.01873d0*t
+|      d  =297.85027d0 + 445267.11135d0*t
+```
+*/
+: terrestrial_time_days{terrestrial_time_days},
+  terrestrial_time_years{(terrestrial_time_days - 51544.0) / 36525.0},
+  terrestrial_time_hours{(terrestrial_time_days - (int)terrestrial_time_days) * 24.0},
+  julian_centuries{(terrestrial_time_days + 2400000.5 - 2451545.0) / 36525.0},
+  pr{terrestrial_time_years * (1.396971278 + terrestrial_time_years * (0.000308889 + terrestrial_time_years
+	* (0.000000021 + terrestrial_time_years * 0.000000007)))},
+  s{argument(s_less_pr(terrestrial_time_years) + pr)},
+  tau{argument(terrestrial_time_hours * 15.0 + 280.4606184 + terrestrial_time_years * (36000.7700536
+	+ terrestrial_time_years * (0.00038793 + terrestrial_time_years * -0.0000000258))
+	- s_less_pr(terrestrial_time_years))},
+  h{argument(280.46645 + terrestrial_time_years * (36000.7697489 + terrestrial_time_years * (0.00030322222
+	+ terrestrial_time_years * (0.000000020 + terrestrial_time_years * -0.00000000654))))},
+  p{argument(83.35324312 + terrestrial_time_years * (4069.01363525 + terrestrial_time_years * (-0.01032172222
+	+ terrestrial_time_years * (-0.0000124991 + terrestrial_time_years * 0.00000005263))))},
+  zns{argument(234.95544499 + terrestrial_time_years * (1934.13626197 + terrestrial_time_years * (-0.00207561111
+	+ terrestrial_time_years * (-0.00000213944 + terrestrial_time_years * 0.00000001650))))},
+  ps{argument(282.93734098 + terrestrial_time_years * (1.71945766667 + terrestrial_time_years * (0.00045688889
+	+ terrestrial_time_years * (-0.00000001778 + terrestrial_time_years * -0.00000000334))))},
+  el0{218.31617 + 481267.88088 * julian_centuries - 1.3972 * julian_centuries},
+  el{argument(134.96292 + 477198.86753 * julian_centuries)},
+  elp{argument(357.52543 + 35999.04944 * julian_centuries)},
+  f{argument(93.27283 + 483202.01873 * julian_centuries)},
+  d{argument(297.85027 + 445267.11135 * julian_centuries)}
+{
+	multiples();
+}
+
+
+FundamentalArguments::FundamentalArguments(double terrestrial_time_days, const FundamentalArguments& previous,
+	const Step& step
+)
+/*
+The arguments at `terrestrial_time_days`, advanced from `previous` by `step` (see `UniformEpochs`). The times are
+ evaluated directly; each argument is rotated by its step.
+*/
+: terrestrial_time_days{terrestrial_time_days},
+  terrestrial_time_years{(terrestrial_time_days - 51544.0) / 36525.0},
+  terrestrial_time_hours{(terrestrial_time_days - (int)terrestrial_time_days) * 24.0},
+  julian_centuries{(terrestrial_time_days + 2400000.5 - 2451545.0) / 36525.0},
+  pr{terrestrial_time_years * (1.396971278 + terrestrial_time_years * (0.000308889 + terrestrial_time_years
+	* (0.000000021 + terrestrial_time_years * 0.000000007)))},
+  s{advance(previous.s, step.s)},
+  tau{advance(previous.tau, step.tau)},
+  h{advance(previous.h, step.h)},
+  p{advance(previous.p, step.p)},
+  zns{advance(previous.zns, step.zns)},
+  ps{advance(previous.ps, step.ps)},
+  el0{previous.el0 + step.el0},
+  el{advance(previous.el, step.el)},
+  elp{advance(previous.elp, step.elp)},
+  f{advance(previous.f, step.f)},
+  d{advance(previous.d, step.d)}
+{
+	multiples();
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+FundamentalArguments::Step FundamentalArguments::step(const FundamentalArguments& from, const FundamentalArguments& to,
+	double fraction
+)
+/*
+The change of every argument over `fraction` of the time from `from` to `to`, for advancing later epochs by that much.
+ Each argument is linear over the span, so a span much longer than the step (see `EpochContext::step`) measures the
+ rate without the rounding of the arguments themselves.
+*/
+{
+	return Step{
+		difference(from.s, to.s, fraction), difference(from.tau, to.tau, fraction), difference(from.h, to.h, fraction),
+		difference(from.p, to.p, fraction), difference(from.zns, to.zns, fraction), difference(from.ps, to.ps, fraction),
+		(to.el0 - from.el0) * fraction, difference(from.el, to.el, fraction), difference(from.elp, to.elp, fraction),
+		difference(from.f, to.f, fraction), difference(from.d, to.d, fraction)
+	};
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void FundamentalArguments::multiples()
+{
+	const Argument* step2_arguments[5] = {&s, &h, &p, &zns, &ps};
+	for(unsigned int index = 0; index < 5; index++)
+	{
+		double* cosine = multiple_cosine[index] + MULTIPLE;
+		double* sine = multiple_sine[index] + MULTIPLE;
+		cosine[0] = 1.0;
+		sine[0] = 0.0;
+		for(int multiple = 1; multiple <= MULTIPLE; multiple++)
+		{
+			cosine[multiple] = cosine[multiple-1] * step2_arguments[index]->cosine - sine[multiple-1]
+				* step2_arguments[index]->sine;
+			sine[multiple] = sine[multiple-1] * step2_arguments[index]->cosine + cosine[multiple-1]
+				* step2_arguments[index]->sine;
+			cosine[-multiple] = cosine[multiple];
+			sine[-multiple] = -sine[multiple];
+		}
+	}
+}
+
+
+FundamentalArguments::Argument FundamentalArguments::argument(double degrees)
+/*
+solid.f [LN 467–472]
+```
+|      s=  dmod(  s,360.d0)
+|      tau=dmod(tau,360.d0)
+⋮
+```
+*/
+{
+	double reduced_degrees = std::fmod(degrees, 360.0);
+	double radians = reduced_degrees / Geolocation::RADIAN;
+	return Argument{reduced_degrees, sin(radians), cos(radians)};
+}
+
+
+FundamentalArguments::Argument FundamentalArguments::advance(const Argument& argument, const Argument& step)
+/*
+`argument` + `step`, kept in (-360°, 360°) like `argument()`.
+*/
+{
+	double degrees = argument.degrees + step.degrees;
+	if(degrees >= 360.0)
+	{
+		degrees -= 360.0;
+	}
+	else if(degrees <= -360.0)
+	{
+		degrees += 360.0;
+	}
+
+	return Argument{degrees, argument.sine * step.cosine + argument.cosine * step.sine,
+		argument.cosine * step.cosine - argument.sine * step.sine};
+}
+
+
+FundamentalArguments::Argument FundamentalArguments::difference(const Argument& from, const Argument& to,
+	double fraction
+)
+/*
+(`to` − `from`) · `fraction`. The difference is taken in [-180°, 180°), so that `tau` & the arguments reduced on either
+ side of a multiple of 360° still give the short way between them.
+*/
+{
+	double degrees = to.degrees - from.degrees;
+	degrees -= 360.0 * std::floor((degrees + 180.0) / 360.0);
+	return argument(degrees * fraction);
+}
+
+
+double FundamentalArguments::s_less_pr(double terrestrial_time_years)
+/*
+solid.f [LN 449–450]
+```
+|      s=218.31664563d0+481267.88194d0*t-0.0014663889d0*t*t
+|     * +0.00000185139d0*t**3
+```
+*/
+{
+	return 218.31664563 + terrestrial_time_years * (481267.88194 + terrestrial_time_years * (-0.0014663889
+		+ terrestrial_time_years * 0.00000185139));
+}
@@ -4,10 +4,169 @@
 
 
 #include "Coordinate.hpp"
+#include "EphemerisCache.hpp"
+#include "EpochContext.hpp"
+#include "FundamentalArguments.hpp"
 #include "JulianDate.hpp"
+#include "StageTimer.hpp"
+#include "StationFrame.hpp"
+
+
+// ————————————————————————————————————————————————— IERS  TABLES ————————————————————————————————————————————————— //
+
+/*
+solid.f [LN 380–389...447]
+```
+|*** cf. table 7.5a of IERS conventions 2003 (TN.32, pg.82)
+|*** columns are s,h,p,N',ps, dR(ip),dR(op),dT(ip),dT(op)
+|*** units of mm
+|
+|      data ((datdi(i,j),i=1,9),j=1,31)/
+|     * -3., 0., 2., 0., 0.,-0.01,-0.01, 0.0 , 0.0,
+⋮
+|     *  3., 0., 0., 1., 0., 0.0 , 0.01, 0.0 , 0.0/
+```
+datdi(1..5,j) — DIURNAL_BAND_MULTIPLIERS[0..4][j]
+datdi(6..9,j) — DIURNAL_BAND_AMPLITUDES[0..3][j]
+*/
+const unsigned int Geolocation::DIURNAL_BAND_ROWS;
+const int Geolocation::DIURNAL_BAND_MULTIPLIERS[5][DIURNAL_BAND_ROWS] = {
+	/* s  */ {
+		-3, -3, -2, -2, -2, -1, -1, -1,  0,  0,  0,  0,  0,  1,  1,  1,
+		 1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  2,  2,  3,  3
+	},
+	/* h  */ {
+		 0,  2,  0,  0,  2,  0,  0,  2, -2,  0,  0,  0,  2, -3, -2, -2,
+		-1, -1,  0,  0,  0,  0,  1,  1,  1,  2,  2, -2,  0,  0,  0
+	},
+	/* p  */ {
+		 2,  0,  1,  1, -1,  0,  0,  0,  1, -1,  1,  1, -1,  0,  0,  0,
+		 0,  0,  0,  0,  0,  0,  0,  0,  0, -2,  0,  1, -1,  0,  0
+	},
+	/* N' */ {
+		 0,  0, -1,  0,  0, -1,  0,  0,  0,  0,  0,  1,  0,  0,  1,  0,
+		 0,  0, -1,  0,  1,  2,  0,  0,  1,  0,  0,  0,  0,  0,  1
+	},
+	/* ps */ {
+		 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,
+		-1,  1,  0,  0,  0,  0, -1,  1, -1,  0,  0,  0,  0,  0,  0
+	}
+};
+const double Geolocation::DIURNAL_BAND_AMPLITUDES[4][DIURNAL_BAND_ROWS] = {
+	/* dR(ip) */ {
+		-0.01, -0.01, -0.02, -0.08, -0.02, -0.10, -0.51,  0.01,  0.01,  0.02,  0.06,  0.01,  0.01, -0.06,  0.01, -1.23,
+		 0.02,  0.04, -0.22, 12.00,  1.73, -0.04, -0.50,  0.01, -0.01, -0.01, -0.11, -0.01, -0.02,  0.00,  0.00
+	},
+	/* dR(op) */ {
+		-0.01, -0.01, -0.01,  0.00, -0.01,  0.00,  0.00,  0.00,  0.00,  0.01,  0.00,  0.00,  0.00,  0.00,  0.00, -0.07,
+		 0.00,  0.00,  0.01, -0.78, -0.12,  0.00, -0.01,  0.00,  0.00,  0.00,  0.01,  0.00,  0.02,  0.01,  0.01
+	},
+	/* dT(ip) */ {
+		 0.00,  0.00,  0.00,  0.01,  0.00,  0.00, -0.02,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.06,
+		 0.00,  0.00,  0.01, -0.67, -0.10,  0.00,  0.03,  0.00,  0.00,  0.00,  0.01,  0.00,  0.00,  0.00,  0.00
+	},
+	/* dT(op) */ {
+		 0.00,  0.00,  0.00,  0.01,  0.00,  0.00,  0.03,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.01,
+		 0.00,  0.00,  0.00, -0.03,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.01,  0.01,  0.00
+	}
+};
+
+/*
+solid.f [LN 516–526]
+```
+|*** cf. table 7.5b of IERS conventions 2003 (TN.32, pg.82)
+|*** columns are s,h,p,N',ps, dR(ip),dT(ip),dR(op),dT(op)
+|*** IERS cols.= s,h,p,N',ps, dR(ip),dR(op),dT(ip),dT(op)
+|*** units of mm
+|
+|      data ((datdi(i,j),i=1,9),j=1,5)/
+|     *   0, 0, 0, 1, 0,   0.47, 0.23, 0.16, 0.07,
+|     *   0, 2, 0, 0, 0,  -0.20,-0.12,-0.11,-0.05,
+|     *   1, 0,-1, 0, 0,  -0.11,-0.08,-0.09,-0.04,
+|     *   2, 0, 0, 0, 0,  -0.13,-0.11,-0.15,-0.07,
+|     *   2, 0, 0, 1, 0,  -0.05,-0.05,-0.06,-0.03/
+```
+datdi(1..5,j) — LONG_PERIOD_BAND_MULTIPLIERS[0..4][j]
+datdi(6..9,j) — LONG_PERIOD_BAND_AMPLITUDES[0..3][j]
+*/
+const unsigned int Geolocation::LONG_PERIOD_BAND_ROWS;
+const int Geolocation::LONG_PERIOD_BAND_MULTIPLIERS[5][LONG_PERIOD_BAND_ROWS] = {
+	/* s  */ {0, 0,  1, 2, 2},
+	/* h  */ {0, 2,  0, 0, 0},
+	/* p  */ {0, 0, -1, 0, 0},
+	/* N' */ {1, 0,  0, 0, 1},
+	/* ps */ {0, 0,  0, 0, 0}
+};
+const double Geolocation::LONG_PERIOD_BAND_AMPLITUDES[4][LONG_PERIOD_BAND_ROWS] = {
+	/* dR(ip) */ { 0.47, -0.20, -0.11, -0.13, -0.05},
+	/* dT(ip) */ { 0.23, -0.12, -0.08, -0.11, -0.05},
+	/* dR(op) */ { 0.16, -0.11, -0.09, -0.15, -0.06},
+	/* dT(op) */ { 0.07, -0.05, -0.04, -0.07, -0.03}
+};
 
 
 Coordinate<double> Geolocation::tide(unsigned int initial_modified_julian_date, JulianDate& julian_date)
+{
+	SOLID_EARTH_TIDE_STAGE(stage_timer, TIME_SCALES);
+	EpochContext epoch_context(initial_modified_julian_date, julian_date);
+	SOLID_EARTH_TIDE_STAGE_STOP(stage_timer);
+	return tide(epoch_context);
+}
+
+
+Coordinate<double> Geolocation::tide(const EpochContext& epoch_context, LunarSeries lunar_series/*=DIRECT*/)
+/*
+solid.f [LN 79–81]
+```
+|        call sunxyz (mjd,fmjd,rsun,lflag)                   !*** mjd/fmjd in UTC
+|        call moonxyz(mjd,fmjd,rmoon,lflag)                  !*** mjd/fmjd in UTC
+|        call detide (xsta,mjd,fmjd,rsun,rmoon,etide,lflag)  !*** mjd/fmjd in UTC
+```
+The epoch's times, Greenwich hour angle & `FundamentalArguments` are evaluated once (in `epoch_context`) & shared by
+ `sunxyz`, `moonxyz`, `step2diu` & `step2lon`. `moonxyz` is evaluated as solid.f does unless `lunar_series` opts in to
+ `LunarSeries::ANGLE_ADDITION`, which differs from it by rounding only (well under 1 µm of displacement).
+*/
+{
+	StationFrame station_frame(*this);
+	Coordinate<double> solar_coordinate = sun_coordinates(epoch_context);
+	Coordinate<double> lunar_coordinate = moon_coordinates(epoch_context, lunar_series);
+	return tide(epoch_context, station_frame, solar_coordinate, lunar_coordinate);
+}
+
+
+Coordinate<double> Geolocation::tide(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+	EphemerisCache& ephemeris_cache
+)
+/*
+Same as `tide(initial_modified_julian_date, julian_date)`, with the sun & moon positions taken from (and memoized in)
+ `ephemeris_cache`, so that queries for an epoch that was already evaluated for another station skip `sunxyz` &
+ `moonxyz`.
+*/
+{
+	StationFrame station_frame(*this);
+	Coordinate<double> solar_coordinate = ephemeris_cache.sun_coordinates(initial_modified_julian_date, julian_date);
+	Coordinate<double> lunar_coordinate = ephemeris_cache.moon_coordinates(initial_modified_julian_date, julian_date);
+	return tide(initial_modified_julian_date, julian_date, station_frame, solar_coordinate, lunar_coordinate);
+}
+
+
+Coordinate<double> Geolocation::tide(unsigned int initial_modified_julian_date, JulianDate& julian_date,
+	const StationFrame& station_frame, Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate
+)
+/*
+Same as `tide(epoch_context, station_frame, solar_coordinate, lunar_coordinate)`, for callers that hold a `JulianDate`.
+*/
+{
+	SOLID_EARTH_TIDE_STAGE(stage_timer, TIME_SCALES);
+	EpochContext epoch_context(initial_modified_julian_date, julian_date);
+	SOLID_EARTH_TIDE_STAGE_STOP(stage_timer);
+	return tide(epoch_context, station_frame, solar_coordinate, lunar_coordinate);
+}
+
+
+Coordinate<double> Geolocation::tide(const EpochContext& epoch_context, const StationFrame& station_frame,
+	Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate
+)
 /*
 solid.f [LN 110–150]
 ```
@@ -53,15 +212,17 @@ solid.f [LN 110–150]
 |*** applied by Dennis Milbert 2007may05
 |*** UTC version by Dennis Milbert 2018june01
 ```
-xsta — geo_coordinate
-mjd — julian_date
-fmjd — julian_date
+xsta — station_frame.geo_coordinate
+mjd, fmjd — epoch_context
 xsun — solar_coordinate
 xmon — lunar_coordinate
 dxtide — 
-lflag — 
+lflag — epoch_context.leap_second_flag
 */
 {
+	SOLID_EARTH_TIDE_STAGE(evaluation_timer, EVALUATION);
+	SOLID_EARTH_TIDE_STAGE(stage_timer, DEGREE_2_3);
+
 	/*
 	solid.f [LN 160–180]
 	```
@@ -87,13 +248,11 @@ lflag —
 	|      t=(dmjdtt-51544.d0)/36525.d0                !*** days to centuries, TT
 	|      fhr=(dmjdtt-int(dmjdtt))*24.d0              !*** hours in the day, TT
 	```
-	dmjdtt — terrestrial_time_days
-	t — terrestrial_time_years
-	fhr — terrestrial_time_hours
+	leapflag — epoch_context.leap_second_flag
+	dmjdtt — epoch_context.terrestrial_time_days
+	t — epoch_context.fundamental_arguments.terrestrial_time_years
+	fhr — epoch_context.terrestrial_time_hours
 	*/
-	double terrestrial_time_days = julian_date.TerrestrialTime(initial_modified_julian_date);
-	double terrestrial_time_years = (terrestrial_time_days - 51544.0) / 36525.0;
-	double terrestrial_time_hours = (terrestrial_time_days - (int)terrestrial_time_days) * 24.0;
 
 	/*
 	solid.f [LN 182–187]
@@ -114,11 +273,8 @@ lflag —
 	scsun — solar_sc
 	scmon — lunar_sc
 	*/
-	Coordinate<double> geo_coordinate = (Coordinate<double>)*this;
-	Coordinate<double> solar_coordinate = sun_coordinates(initial_modified_julian_date, julian_date);
-	Coordinate<double> lunar_coordinate = moon_coordinates(initial_modified_julian_date, julian_date);
-
-	double geo_distance  = sqrt(geo_coordinate * geo_coordinate);
+	const Coordinate<double>& geo_coordinate = station_frame.geo_coordinate;
+	double geo_distance = station_frame.distance;
 	double solar_distance = sqrt(solar_coordinate * solar_coordinate);
 	double lunar_distance = sqrt(lunar_coordinate * lunar_coordinate);
 
@@ -147,7 +303,7 @@ lflag —
 	|      p3sun=5.d0/2.d0*(h3-3.d0*l3)*scsun**3+3.d0/2.d0*(l3-h3)*scsun
 	|      p3mon=5.d0/2.d0*(h3-3.d0*l3)*scmon**3+3.d0/2.d0*(l3-h3)*scmon
 	```
-	cosphi — cos_ϕ
+	cosphi, h2, l2 — (derived once per station in StationFrame)
 	h2 — second_degree_love
 	l2 — second_degree_shida
 	p2sun — solar_p2
@@ -155,17 +311,16 @@ lflag —
 	p3sun — solar_p3
 	p3mon — lunar_p3
 	*/
-	double cos_ϕ = sqrt(geo_coordinate[Y] * geo_coordinate[Y] + geo_coordinate[Z] * geo_coordinate[Z]) / geo_distance;
-	double second_degree_love = SECOND_DEGREE_LOVE - 0.0006 * (1.0 - 3.0 / 2.0 * cos_ϕ * cos_ϕ);
-	double second_degree_shida = SECOND_DEGREE_SHIDA + 0.0002 * (1.0 - 3.0 / 2.0 * cos_ϕ * cos_ϕ);
+	double second_degree_love = station_frame.second_degree_love;
+	double second_degree_shida = station_frame.second_degree_shida;
 
 	double p2_pre_op = 3.0 * (second_degree_love / 2.0 - second_degree_shida);
 	double solar_p2 = p2_pre_op * pow(solar_sc, 2) - second_degree_love / 2.0;
 	double lunar_p2 = p2_pre_op * pow(lunar_sc, 2) - second_degree_love / 2.0;
 
 	double p3_pre_op = 2.5 * (THIRD_DEGREE_LOVE - 3.0 * THIRD_DEGREE_SHIDA);
-	double solar_p3 = p3_pre_op * pow(solar_sc, 3) + 1.5 * THIRD_DEGREE_SHIDA - THIRD_DEGREE_LOVE * solar_sc;
-	double lunar_p3 = p3_pre_op * pow(lunar_sc, 3) + 1.5 * THIRD_DEGREE_SHIDA - THIRD_DEGREE_LOVE * lunar_sc;
+	double solar_p3 = p3_pre_op * pow(solar_sc, 3) + 1.5 * (THIRD_DEGREE_SHIDA - THIRD_DEGREE_LOVE) * solar_sc;
+	double lunar_p3 = p3_pre_op * pow(lunar_sc, 3) + 1.5 * (THIRD_DEGREE_SHIDA - THIRD_DEGREE_LOVE) * lunar_sc;
 
 	/*
 	solid.f [LN 205–210]
@@ -229,13 +384,13 @@ lflag —
 	{
 		detide[index] =
 			solar_factor2 * (solar_direction2 * solar_coordinate[index] / solar_distance
-				+ solar_p2 * geo_coordinate[index] / geo_distance)
+				+ solar_p2 * station_frame.up[index])
 			+ lunar_factor2 * (lunar_direction2 * lunar_coordinate[index] / lunar_distance
-				+ lunar_p2 * geo_coordinate[index] / geo_distance)
+				+ lunar_p2 * station_frame.up[index])
 			+ solar_factor3 * (solar_direction3 * solar_coordinate[index] / solar_distance
-				+ solar_p3 * geo_coordinate[index] / geo_distance)
+				+ solar_p3 * station_frame.up[index])
 			+ lunar_factor3 * (lunar_direction3 * lunar_coordinate[index] / lunar_distance
-				+ lunar_p3 * geo_coordinate[index] / geo_distance);
+				+ lunar_p3 * station_frame.up[index]);
 	}
 
 	/*
@@ -252,7 +407,8 @@ lflag —
 	|      dxtide(3)=dxtide(3)+xcorsta(3)
 	```
 	*/
-	Coordinate<double> corrected_geo_coordinate_1st = mantle_inelasticity_1st_diurnal_band_correction(geo_coordinate,
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, STEP1_DIURNAL);
+	Coordinate<double> corrected_geo_coordinate_1st = mantle_inelasticity_1st_diurnal_band_correction(station_frame,
 		solar_coordinate, lunar_coordinate, solar_factor2, lunar_factor2);
 	detide += corrected_geo_coordinate_1st;
 
@@ -267,7 +423,8 @@ lflag —
 	|      dxtide(3)=dxtide(3)+xcorsta(3)
 	```
 	*/
-	Coordinate<double> corrected_geo_coordinate_semi = mantle_inelasticity_semi_diurnal_band_correction(geo_coordinate,
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, STEP1_SEMI_DIURNAL);
+	Coordinate<double> corrected_geo_coordinate_semi = mantle_inelasticity_semi_diurnal_band_correction(station_frame,
 		solar_coordinate, lunar_coordinate, solar_factor2, lunar_factor2);
 	detide += corrected_geo_coordinate_semi;
 
@@ -282,7 +439,8 @@ lflag —
 	|      dxtide(3)=dxtide(3)+xcorsta(3)
 	```
 	*/
-	Coordinate<double> corrected_latitude_dependence = latitude_dependence_correction(geo_coordinate,
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, STEP1_LATITUDE_DEPENDENCE);
+	Coordinate<double> corrected_latitude_dependence = latitude_dependence_correction(station_frame,
 		solar_coordinate, lunar_coordinate, solar_factor2, lunar_factor2);
 	detide += corrected_latitude_dependence;
 
@@ -307,8 +465,9 @@ lflag —
 	|      dxtide(3)=dxtide(3)+xcorsta(3)
 	```
 	*/
-	Coordinate<double> corrected_second_diurnal_band = second_step_diurnal_band_correction(geo_coordinate,
-		terrestrial_time_hours, terrestrial_time_years);
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, STEP2_DIURNAL);
+	Coordinate<double> corrected_second_diurnal_band = second_step_diurnal_band_correction(station_frame,
+		epoch_context);
 	detide += corrected_second_diurnal_band;
 
 	/*
@@ -323,9 +482,11 @@ lflag —
 	|      dxtide(3)=dxtide(3)+xcorsta(3)
 	```
 	*/
-	Coordinate<double> corrected_second_longitude = second_step_longitudinal_correction(geo_coordinate,
-		terrestrial_time_hours, terrestrial_time_years);
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, STEP2_LONG_PERIOD);
+	Coordinate<double> corrected_second_longitude = second_step_longitudinal_correction(station_frame,
+		epoch_context);
 	detide += corrected_second_longitude;
+	SOLID_EARTH_TIDE_STAGE_STOP(stage_timer);
 			
 	/*
 	solid.f [LN 281–303]
@@ -359,9 +520,9 @@ lflag —
 }
 
 
-Coordinate<double> Geolocation::mantle_inelasticity_1st_diurnal_band_correction(Coordinate<double>& geo_coordinate, 
+Coordinate<double> Geolocation::mantle_inelasticity_1st_diurnal_band_correction(const StationFrame& station_frame,
 	Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-	double lunar_factor2 
+	double lunar_factor2
 )
 /*
 solid.f [LN 589–595]
@@ -374,7 +535,7 @@ solid.f [LN 589–595]
 |***  input: xsta,xsun,xmon,fac2sun,fac2mon
 |*** output: xcorsta
 ```
-xsta — geo_coordinate
+xsta — station_frame
 xsun — solar_coordinate
 xmon — lunar_coordinate
 fac2sun — solar_factor2
@@ -394,7 +555,7 @@ xcorsta — [returned]
 	|      rmon=enorm8(xmon)
 	|      rsun=enorm8(xsun)
 	```
-	rsta — geo_distance
+	rsta — station_frame.distance (the station terms are all derived once, in StationFrame)
 	sinphi — sin_ϕ
 	cosphi — cos_ϕ
 	cos2phi — cos_squared_ϕ
@@ -403,12 +564,11 @@ xcorsta — [returned]
 	rmon — lunar_distance
 	rsun — solar_distance
 	*/
-	double geo_distance = geo_coordinate.distance();
-	double sin_ϕ = geo_coordinate[Z] / geo_distance;
-	double cos_ϕ = sqrt(pow(geo_coordinate[X], 2) + pow(geo_coordinate[Y], 2)) / geo_distance;
-	double cos_squared_ϕ = pow(cos_ϕ, 2) - pow(sin_ϕ, 2);
-	double sin_latitude = geo_coordinate[Y] / cos_ϕ / geo_distance;
-	double cos_latitude = geo_coordinate[X] / cos_ϕ / geo_distance;
+	double sin_ϕ = station_frame.sin_ϕ;
+	double cos_ϕ = station_frame.cos_ϕ;
+	double cos_squared_ϕ = station_frame.cos_2ϕ;
+	double sin_latitude = station_frame.sin_λ;
+	double cos_latitude = station_frame.cos_λ;
 	double lunar_distance = lunar_coordinate.distance();
 	double solar_distance = solar_coordinate.distance();
 
@@ -435,33 +595,33 @@ xcorsta — [returned]
 	|      xcorsta(3)=dr*sinphi               +dn*cosphi
 	```
 	*/
-	double solar_dr = -3.0 * -0.0022 * sin_ϕ * cos_ϕ * solar_factor2 * solar_coordinate[Z]
+	double solar_dr = -3.0 * -0.0025 * sin_ϕ * cos_ϕ * solar_factor2 * solar_coordinate[Z]
 		* (solar_coordinate[X] * sin_latitude - solar_coordinate[Y] * cos_latitude) / pow(solar_distance, 2);
-	double lunar_dr = -3.0 * -0.0022 * sin_ϕ * cos_ϕ * lunar_factor2 * lunar_coordinate[Z]
+	double lunar_dr = -3.0 * -0.0025 * sin_ϕ * cos_ϕ * lunar_factor2 * lunar_coordinate[Z]
 		* (lunar_coordinate[X] * sin_latitude - lunar_coordinate[Y] * cos_latitude) / pow(lunar_distance, 2);
 	double solar_dn = -3.0 * -0.0007 * cos_squared_ϕ * solar_factor2 * solar_coordinate[Z]
 		* (solar_coordinate[X] * sin_latitude - solar_coordinate[Y] * cos_latitude) / pow(solar_distance, 2);
 	double lunar_dn = -3.0 * -0.0007 * cos_squared_ϕ * lunar_factor2 * lunar_coordinate[Z]
 		* (lunar_coordinate[X] * sin_latitude - lunar_coordinate[Y] * cos_latitude) / pow(lunar_distance, 2);
 	double solar_de = -3.0 * -0.0007 * sin_ϕ * solar_factor2 * solar_coordinate[Z]
-		* (solar_coordinate[X] * cos_latitude * solar_coordinate[Y] * sin_latitude) / pow(solar_distance, 2);
+		* (solar_coordinate[X] * cos_latitude + solar_coordinate[Y] * sin_latitude) / pow(solar_distance, 2);
 	double lunar_de = -3.0 * -0.0007 * sin_ϕ * lunar_factor2 * lunar_coordinate[Z]
-		* (lunar_coordinate[X] * cos_latitude * lunar_coordinate[Y] * sin_latitude) / pow(lunar_distance, 2);
+		* (lunar_coordinate[X] * cos_latitude + lunar_coordinate[Y] * sin_latitude) / pow(lunar_distance, 2);
 
 	double dr = solar_dr + lunar_dr;
 	double dn = solar_dn + lunar_dn;
 	double de = solar_de + lunar_de;
 	return Coordinate<double>(
-		dr * cos_latitude * cos_ϕ - de * sin_latitude - dn * sin_ϕ * cos_latitude,
-		dr * sin_latitude * cos_ϕ + de * cos_latitude - dn * sin_ϕ * sin_latitude,
-		dr * sin_ϕ + dn * cos_ϕ
+		dr * station_frame.up[X] + de * station_frame.east[X] + dn * station_frame.north[X],
+		dr * station_frame.up[Y] + de * station_frame.east[Y] + dn * station_frame.north[Y],
+		dr * station_frame.up[Z] + dn * station_frame.north[Z]
 	);
 }
 
 
-Coordinate<double> Geolocation::mantle_inelasticity_semi_diurnal_band_correction(Coordinate<double>& geo_coordinate, 
+Coordinate<double> Geolocation::mantle_inelasticity_semi_diurnal_band_correction(const StationFrame& station_frame,
 	Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-	double lunar_factor2 
+	double lunar_factor2
 )
 /*
 solid.f [LN 631–637]
@@ -473,7 +633,7 @@ solid.f [LN 631–637]
 |
 |***  input: xsta,xsun,xmon,fac2sun,fac2mon
 |*** output: xcorsta
-xsta — geo_coordinate
+xsta — station_frame
 xsun — solar_coordinate
 xmon — lunar_coordinate
 fac2sun — solar_factor2
@@ -495,7 +655,7 @@ xcorsta — [returned]
 	|      rmon=enorm8(xmon)
 	|      rsun=enorm8(xsun)
 	```
-	rsta — geo_distance
+	rsta — station_frame.distance (the station terms are all derived once, in StationFrame)
 	sinphi — sin_ϕ
 	cosphi — cos_ϕ
 	sinla — sin_latitude
@@ -505,13 +665,10 @@ xcorsta — [returned]
 	rmon — lunar_distance
 	rsun — solar_distance
 	*/
-	double geo_distance = geo_coordinate.distance();
-	double sin_ϕ = geo_coordinate[Z] / geo_distance;
-	double cos_ϕ = sqrt(pow(geo_coordinate[X], 2) + pow(geo_coordinate[Y], 2)) / geo_distance;
-	double sin_latitude = geo_coordinate[Y] / cos_ϕ / geo_distance;
-	double cos_latitude = geo_coordinate[X] / cos_ϕ / geo_distance;
-	double cos_squared_latitude = pow(cos_ϕ, 2) - pow(sin_ϕ, 2);
-	double sin_squared_latitude = 2.0 * cos_latitude * sin_latitude;
+	double sin_ϕ = station_frame.sin_ϕ;
+	double cos_ϕ = station_frame.cos_ϕ;
+	double cos_squared_latitude = station_frame.cos_2λ;
+	double sin_squared_latitude = station_frame.sin_2λ;
 	double lunar_distance = lunar_coordinate.distance();
 	double solar_distance = solar_coordinate.distance();
 
@@ -538,11 +695,11 @@ xcorsta — [returned]
 	|      xcorsta(3)=dr*sinphi+dn*cosphi
 	```
 	*/
-	double solar_dr = -3.0 / 4.0 * -0.0022 * pow(cos_ϕ, 2) * solar_factor2
+	double solar_dr = -3.0 / 4.0 * -0.0022 * station_frame.cos_squared_ϕ * solar_factor2
 		* ((pow(solar_coordinate[X], 2) - pow(solar_coordinate[Y], 2))
 			* sin_squared_latitude-2.0 * solar_coordinate[X] * solar_coordinate[Y] * cos_squared_latitude)
 			/ pow(solar_distance, 2);
-	double lunar_dr = -3.0 / 4.0 * -0.0022 * pow(cos_ϕ, 2) * lunar_factor2
+	double lunar_dr = -3.0 / 4.0 * -0.0022 * station_frame.cos_squared_ϕ * lunar_factor2
 		* ((pow(lunar_coordinate[X], 2) - pow(lunar_coordinate[Y], 2))
 			* sin_squared_latitude-2.0 * lunar_coordinate[X] * lunar_coordinate[Y] * cos_squared_latitude)
 			/ pow(lunar_distance, 2);
@@ -567,16 +724,16 @@ xcorsta — [returned]
 	double dn = solar_dn + lunar_dn;
 	double de = solar_de + lunar_de;
 	return Coordinate<double>(
-		dr * cos_latitude * cos_ϕ - de * sin_latitude - dn * sin_ϕ * cos_latitude,
-		dr * sin_latitude * cos_ϕ + de * cos_latitude - dn * sin_ϕ * sin_latitude,
-		dr * sin_ϕ + dn * cos_ϕ
+		dr * station_frame.up[X] + de * station_frame.east[X] + dn * station_frame.north[X],
+		dr * station_frame.up[Y] + de * station_frame.east[Y] + dn * station_frame.north[Y],
+		dr * station_frame.up[Z] + dn * station_frame.north[Z]
 	);
 }
 
 
-Coordinate<double> Geolocation::latitude_dependence_correction(Coordinate<double>& geo_coordinate, 
+Coordinate<double> Geolocation::latitude_dependence_correction(const StationFrame& station_frame,
 	Coordinate<double>& solar_coordinate, Coordinate<double>& lunar_coordinate, double solar_factor2,
-	double lunar_factor2 
+	double lunar_factor2
 )
 /*
 solid.f [308–314]
@@ -589,7 +746,7 @@ solid.f [308–314]
 |***  input: xsta,xsun,xmon,fac3sun,fac3mon
 |*** output: xcorsta
 ```
-xsta — geo_coordinate
+xsta — station_frame
 xsun — solar_coordinate
 xmon — lunar_coordinate
 fac2sun — solar_factor2
@@ -608,7 +765,7 @@ xcorsta — [returned]
 	|      rmon=enorm8(xmon)
 	|      rsun=enorm8(xsun)
 	```
-	rsta — geo_distance
+	rsta — station_frame.distance (the station terms are all derived once, in StationFrame)
 	sinphi — sin_ϕ
 	cosphi — cos_ϕ
 	sinla — sin_latitude
@@ -616,11 +773,11 @@ xcorsta — [returned]
 	rmon — lunar_distance
 	rsun — solar_distance
 	*/
-	double geo_distance = geo_coordinate.distance();
-	double sin_ϕ = geo_coordinate[Z] / geo_distance;
-	double cos_ϕ = sqrt(pow(geo_coordinate[X], 2) + pow(geo_coordinate[Y], 2)) / geo_distance;
-	double sin_latitude = geo_coordinate[Y] / cos_ϕ / geo_distance;
-	double cos_latitude = geo_coordinate[X] / cos_ϕ / geo_distance;
+	double sin_ϕ = station_frame.sin_ϕ;
+	double sin_squared_ϕ = station_frame.sin_squared_ϕ;
+	double cos_2ϕ = station_frame.cos_2ϕ;
+	double sin_latitude = station_frame.sin_λ;
+	double cos_latitude = station_frame.cos_λ;
 	double lunar_distance = lunar_coordinate.distance();
 	double solar_distance = solar_coordinate.distance();
 
@@ -645,20 +802,21 @@ xcorsta — [returned]
 	|      xcorsta(3)=          dn*cosphi
 	```
 	*/
-	double solar_diurnal_dn = -0.0012 * pow(sin_ϕ, 2) * solar_factor2 * solar_coordinate[Z]
+	double solar_diurnal_dn = -0.0012 * sin_squared_ϕ * solar_factor2 * solar_coordinate[Z]
 		* (solar_coordinate[X] * cos_latitude + solar_coordinate[Y] * sin_latitude) / pow(solar_distance, 2);
-	double lunar_diurnal_dn = -0.0012 * pow(sin_ϕ, 2) * lunar_factor2 * lunar_coordinate[Z]
+	double lunar_diurnal_dn = -0.0012 * sin_squared_ϕ * lunar_factor2 * lunar_coordinate[Z]
 		* (lunar_coordinate[X] * cos_latitude + lunar_coordinate[Y] * sin_latitude) / pow(lunar_distance, 2);
-	double solar_diurnal_de = 0.0012 * sin_ϕ * (pow(cos_ϕ, 2) - pow(sin_ϕ, 2)) * solar_factor2 * solar_coordinate[Z]
+	double solar_diurnal_de = 0.0012 * sin_ϕ * cos_2ϕ * solar_factor2 * solar_coordinate[Z]
 		* (solar_coordinate[X] * sin_latitude - solar_coordinate[Y] * cos_latitude) / pow(solar_distance, 2);
-	double lunar_diurnal_de = 0.0012 * sin_ϕ * (pow(cos_ϕ, 2) - pow(sin_ϕ, 2)) * lunar_factor2 * lunar_coordinate[Z]
+	double lunar_diurnal_de = 0.0012 * sin_ϕ * cos_2ϕ * lunar_factor2 * lunar_coordinate[Z]
 		* (lunar_coordinate[X] * sin_latitude - lunar_coordinate[Y] * cos_latitude) / pow(lunar_distance, 2);
 	double diurnal_de = 3.0 * (solar_diurnal_de +  lunar_diurnal_de);
 	double diurnal_dn = 3.0 * (solar_diurnal_dn +  lunar_diurnal_dn);
 
-	Coordinate<double> diurnal_band_correction(-diurnal_de * sin_latitude - diurnal_dn * sin_ϕ * cos_latitude,
-		diurnal_de * cos_latitude - diurnal_dn * sin_ϕ * sin_latitude,
-		diurnal_dn * cos_ϕ
+	Coordinate<double> diurnal_band_correction(
+		diurnal_de * station_frame.east[X] + diurnal_dn * station_frame.north[X],
+		diurnal_de * station_frame.east[Y] + diurnal_dn * station_frame.north[Y],
+		diurnal_dn * station_frame.north[Z]
 	);
 
 	/*
@@ -684,36 +842,38 @@ xcorsta — [returned]
 	|      xcorsta(3)=xcorsta(3)         +dn*cosphi
 	```
 	*/
-	double cos_squared_latitude = pow(cos_latitude, 2) - pow(sin_latitude, 2);
-	double sin_squared_latitude = 2.0 * cos_latitude * sin_latitude;
-	double solar_semi_dn = -0.0024 / 2.0 * sin_ϕ * cos_ϕ * solar_factor2
-		* ((pow(solar_coordinate[X], 2) - pow(solar_coordinate[Z], 2))
+	double cos_squared_latitude = station_frame.cos_2λ;
+	double sin_squared_latitude = station_frame.sin_2λ;
+	double sin_cos_ϕ = station_frame.sin_2ϕ / 2.0;
+	double sin_squared_cos_ϕ = sin_squared_ϕ * station_frame.cos_ϕ;
+	double solar_semi_dn = -0.0024 / 2.0 * sin_cos_ϕ * solar_factor2
+		* ((pow(solar_coordinate[X], 2) - pow(solar_coordinate[Y], 2))
 			* cos_squared_latitude + 2.0 * solar_coordinate[X] * solar_coordinate[Y] * sin_squared_latitude)
 		/ pow(solar_distance, 2);
-	double lunar_semi_dn = -0.0024 / 2.0 * sin_ϕ * cos_ϕ * lunar_factor2
+	double lunar_semi_dn = -0.0024 / 2.0 * sin_cos_ϕ * lunar_factor2
 		* ((pow(lunar_coordinate[X], 2) - pow(lunar_coordinate[Y], 2))
 			* cos_squared_latitude + 2.0 * lunar_coordinate[X] * lunar_coordinate[Y] * sin_squared_latitude)
 		/ pow(lunar_distance, 2);
-	double solar_semi_de = -0.0024 / 2.0 * pow(sin_ϕ, 2) * cos_ϕ * solar_factor2
+	double solar_semi_de = -0.0024 / 2.0 * sin_squared_cos_ϕ * solar_factor2
 		* ((pow(solar_coordinate[X], 2) - pow(solar_coordinate[Y], 2))
 			* sin_squared_latitude - 2.0 * solar_coordinate[X] * solar_coordinate[Y] * cos_squared_latitude)
 		/ pow(solar_distance, 2);
-	double lunar_semi_de = -0.0024 / 2.0 * pow(sin_ϕ, 2) * cos_ϕ * lunar_factor2
+	double lunar_semi_de = -0.0024 / 2.0 * sin_squared_cos_ϕ * lunar_factor2
 		* ((pow(lunar_coordinate[X], 2) - pow(lunar_coordinate[Y], 2))
 			* sin_squared_latitude - 2.0 * lunar_coordinate[X] * lunar_coordinate[Y] * cos_squared_latitude)
 		/ pow(lunar_distance, 2);
 	double semi_de = 3.0 * (solar_semi_de + lunar_semi_de);
 	double semi_dn = 3.0 * (solar_semi_dn + lunar_semi_dn);
 	return Coordinate<double>(
-		diurnal_band_correction[X] - semi_de * sin_latitude - semi_dn * sin_ϕ * cos_latitude,
-		diurnal_band_correction[Y] + semi_de * cos_latitude - semi_dn * sin_ϕ * sin_latitude,
-		diurnal_band_correction[Z] + semi_dn * cos_ϕ
+		diurnal_band_correction[X] + semi_de * station_frame.east[X] + semi_dn * station_frame.north[X],
+		diurnal_band_correction[Y] + semi_de * station_frame.east[Y] + semi_dn * station_frame.north[Y],
+		diurnal_band_correction[Z] + semi_dn * station_frame.north[Z]
 	);
 }
 
 
-Coordinate<double> Geolocation::second_step_diurnal_band_correction(Coordinate<double>& geo_coordinate,
-	double terrestrial_time_hours, double terrestrial_time_years
+Coordinate<double> Geolocation::second_step_diurnal_band_correction(const StationFrame& station_frame,
+	const EpochContext& epoch_context
 )
 /*
 solid.f [LN 368–373...380–386]
@@ -733,120 +893,11 @@ solid.f [LN 368–373...380–386]
 |*** columns are s,h,p,N',ps, dR(ip),dR(op),dT(ip),dT(op)
 |*** units of mm
 ```
-xsta — geo_coordinate
-fhr — terrestrial_time_hours
-t — terrestrial_time_years
+xsta — station_frame
+fhr, t — epoch_context (s, tau, h, p, zns & ps are evaluated & reduced in its `FundamentalArguments` [solid.f LN 449–472])
 xcorsta — [returned]
 */
 {
-	/*
-	solid.f [LN 388–389...447]
-	```
-	|      data ((datdi(i,j),i=1,9),j=1,31)/
-	|     * -3., 0., 2., 0., 0.,-0.01,-0.01, 0.0 , 0.0,
-	⋮
-	|     *  3., 0., 0., 1., 0., 0.0 , 0.01, 0.0 , 0.0/
-	```
-	datdi — IERS_conversion
-	Notably, Fortran uses column-major order, which is the oppose of C++. Column-major order maintains continuity of the
-	 left-most index.
-	*/
-
-	double IERS_conversion[31][9] = {
-		{-3.0,  0.0,  2.0,  0.0,  0.0, -0.01, -0.01,   0.0,   0.0},
-		{-3.0,  2.0,  0.0,  0.0,  0.0, -0.01, -0.01,   0.0,   0.0},
-		{-2.0,  0.0,  1.0, -1.0,  0.0, -0.02, -0.01,   0.0,   0.0},
-		{-2.0,  0.0,  1.0,  0.0,  0.0, -0.08,   0.0,  0.01,  0.01},
-		{-2.0,  2.0, -1.0,  0.0,  0.0, -0.02, -0.01,   0.0,   0.0},
-		{-1.0,  0.0,  0.0, -1.0,  0.0, -0.10,   0.0,   0.0,   0.0},
-		{-1.0,  0.0,  0.0,  0.0,  0.0, -0.51,   0.0, -0.02,  0.03},
-		{-1.0,  2.0,  0.0,  0.0,  0.0,  0.01,   0.0,   0.0,   0.0},
-		{ 0.0, -2.0,  1.0,  0.0,  0.0,  0.01,   0.0,   0.0,   0.0},
-		{ 0.0,  0.0, -1.0,  0.0,  0.0,  0.02,  0.01,   0.0,   0.0},
-		{ 0.0,  0.0,  1.0,  0.0,  0.0,  0.06,   0.0,   0.0,   0.0},
-		{ 0.0,  0.0,  1.0,  1.0,  0.0,  0.01,   0.0,   0.0,   0.0},
-		{ 0.0,  2.0, -1.0,  0.0,  0.0,  0.01,   0.0,   0.0,   0.0},
-		{ 1.0, -3.0,  0.0,  0.0,  1.0, -0.06,   0.0,   0.0,   0.0},
-		{ 1.0, -2.0,  0.0,  1.0,  0.0,  0.01,   0.0,   0.0,   0.0},
-		{ 1.0, -2.0,  0.0,  0.0,  0.0, -1.23, -0.07,  0.06,  0.01},
-		{ 1.0, -1.0,  0.0,  0.0, -1.0,  0.02,   0.0,   0.0,   0.0},
-		{ 1.0, -1.0,  0.0,  0.0,  1.0,  0.04,   0.0,   0.0,   0.0},
-		{ 1.0,  0.0,  0.0, -1.0,  0.0, -0.22,  0.01,  0.01,   0.0},
-		{ 1.0,  0.0,  0.0,  0.0,  0.0, 12.00, -0.78, -0.67, -0.03},
-		{ 1.0,  0.0,  0.0,  1.0,  0.0,  1.73, -0.12, -0.10,   0.0},
-		{ 1.0,  0.0,  0.0,  2.0,  0.0, -0.04,   0.0,   0.0,   0.0},
-		{ 1.0,  1.0,  0.0,  0.0, -1.0, -0.50, -0.01,  0.03,   0.0},
-		{ 1.0,  1.0,  0.0,  0.0,  1.0,  0.01,   0.0,   0.0,   0.0},
-		{ 1.0,  1.0,  0.0,  1.0, -1.0, -0.01,   0.0,   0.0,   0.0},
-		{ 1.0,  2.0, -2.0,  0.0,  0.0, -0.01,   0.0,   0.0,   0.0},
-		{ 1.0,  2.0,  0.0,  0.0,  0.0, -0.11,  0.01,  0.01,   0.0},
-		{ 2.0, -2.0,  1.0,  0.0,  0.0, -0.01,   0.0,   0.0,   0.0},
-		{ 2.0,  0.0, -1.0,  0.0,  0.0, -0.02,  0.02,   0.0,  0.01},
-		{ 3.0,  0.0,  0.0,  0.0,  0.0,   0.0,  0.01,   0.0,  0.01},
-		{ 3.0,  0.0,  0.0,  1.0,  0.0,   0.0,  0.01,   0.0,   0.0}
-	};
-
-	/*
-	solid.f [LN 449–463]
-	```
-	|      s=218.31664563d0+481267.88194d0*t-0.0014663889d0*t*t
-	|     * +0.00000185139d0*t**3
-	|      tau=fhr*15.d0+280.4606184d0+36000.7700536d0*t+0.00038793d0*t*t
-	|     * -0.0000000258d0*t**3-s
-	|      pr=1.396971278*t+0.000308889*t*t+0.000000021*t**3
-	|     * +0.000000007*t**4
-	|      s=s+pr
-	|      h=280.46645d0+36000.7697489d0*t+0.00030322222d0*t*t
-	|     * +0.000000020*t**3-0.00000000654*t**4
-	|      p=83.35324312d0+4069.01363525d0*t-0.01032172222d0*t*t
-	|     * -0.0000124991d0*t**3+0.00000005263d0*t**4
-	|      zns=234.95544499d0 +1934.13626197d0*t-0.00207561111d0*t*t
-	|     * -0.00000213944d0*t**3+0.00000001650d0*t**4
-	|      ps=282.93734098d0+1.71945766667d0*t+0.00045688889d0*t*t
-	|     * -0.00000001778d0*t**3-0.00000000334d0*t**4
-	```
-	*/
-	double s_less_pr = 218.31664563 + 481267.88194 * terrestrial_time_years - 0.0014663889 * terrestrial_time_years
-		* terrestrial_time_years + 0.00000185139 * pow(terrestrial_time_years, 3);
-	double tau_part = terrestrial_time_hours * 15.0 + 280.4606184 + 36000.7700536 * terrestrial_time_years
-		+ 0.00038793 * terrestrial_time_years * terrestrial_time_years - 0.0000000258
-		* pow(terrestrial_time_years, 3) - s_less_pr;
-	double pr = 1.396971278 * terrestrial_time_years + 0.000308889 * terrestrial_time_years
-		* terrestrial_time_years + 0.000000021 * pow(terrestrial_time_years, 3) + 0.000000007
-		* pow(terrestrial_time_years, 4);
-	double h_part = 280.46645 + 36000.7697489 * terrestrial_time_years + 0.00030322222 * terrestrial_time_years
-		* terrestrial_time_years + 0.000000020 * pow(terrestrial_time_years, 3) - 0.00000000654
-		* pow(terrestrial_time_years, 4);
-	double p_part = 83.35324312 + 4069.01363525 * terrestrial_time_years - 0.01032172222 * terrestrial_time_years
-		* terrestrial_time_years - 0.0000124991 * pow(terrestrial_time_years, 3) + 0.00000005263
-		* pow(terrestrial_time_years, 4);
-	double zns_part = 234.95544499  + 1934.13626197 * terrestrial_time_years - 0.00207561111
-		* terrestrial_time_years * terrestrial_time_years - 0.00000213944 * pow(terrestrial_time_years, 3)
-		+ 0.00000001650 * pow(terrestrial_time_years, 4);
-	double ps_part = 282.93734098 + 1.71945766667 * terrestrial_time_years + 0.00045688889 * terrestrial_time_years
-		* terrestrial_time_years - 0.00000001778 * pow(terrestrial_time_years, 3) - 0.00000000334
-		* pow(terrestrial_time_years, 4);
-
-	/*
-	solid.f [LN 465–472]
-	```
-	|*** reduce angles to between 0 and 360
-	|
-	|      s=  dmod(  s,360.d0)
-	|      tau=dmod(tau,360.d0)
-	|      h=  dmod(  h,360.d0)
-	|      p=  dmod(  p,360.d0)
-	|      zns=dmod(zns,360.d0)
-	|      ps= dmod( ps,360.d0)
-	```
-	*/
-	double s = std::fmod(s_less_pr + pr, 360.0);
-	double tau = std::fmod(tau_part, 360.0);
-	double h = std::fmod(h_part, 360.0);
-	double p = std::fmod(p_part, 360.0);
-	double zns = std::fmod(zns_part, 360.0);
-	double ps = std::fmod(ps_part, 360.0);
-
 	/*
 	solid.f [LN 474–480]
 	```
@@ -858,30 +909,14 @@ xcorsta — [returned]
 	|      sinla=xsta(2)/cosphi/rsta
 	|      zla = datan2(xsta(2),xsta(1))
 	```
-	rsta — geo_distance
+	rsta — station_frame.distance (the station terms are all derived once, in StationFrame)
 	sinphi — sin_ϕ
 	cosphi — cos_ϕ
-	cosla — cos_latitude
-	sinla — sin_latitude
-	zla — Z_latitude
+	zla — station_frame.λ
 	*/
-	double geo_distance = geo_coordinate.distance();
-	double sin_ϕ = geo_coordinate[Z] / geo_distance;
-	double cos_ϕ = sqrt(pow(geo_coordinate[X], 2) + pow(geo_coordinate[Y], 2)) / geo_distance;
-
-	double cos_latitude = geo_coordinate[X] / cos_ϕ / geo_distance;
-	double sin_latitude = geo_coordinate[Y] / cos_ϕ / geo_distance;
-	double Z_latitude = atan2(geo_coordinate[Y], geo_coordinate[X]);
-
-	/*
-	solid.f [LN 481–483]
-	```
-	|      do i=1,3
-	|        xcorsta(i)=0.d0
-	|      enddo
-	```
-	*/
-	Coordinate<double> correction;
+	double sin_ϕ = station_frame.sin_ϕ;
+	double sin_2ϕ = station_frame.sin_2ϕ;
+	double cos_2ϕ = station_frame.cos_2ϕ;
 
 	/*
 	solid.f [LN 484–504]
@@ -908,100 +943,67 @@ xcorsta — [returned]
 	|         xcorsta(i)=xcorsta(i)/1000.d0
 	|      enddo
 	```
+	thetaf + zla is tau + zla plus an integer combination of s, h, p, N' & ps, so its cosine & sine are built by complex
+	 multiplication from those of tau & zla & the arguments' precomputed multiples, rather than by `sin`/`cos`.
 	*/
-	for(unsigned int row = 0; row < 31; row++)
+	const FundamentalArguments& fundamental_arguments = epoch_context.fundamental_arguments;
+	const FundamentalArguments::Argument& tau = fundamental_arguments.tau;
+	double cos_tau_zla = tau.cosine * station_frame.cos_λ - tau.sine * station_frame.sin_λ;
+	double sin_tau_zla = tau.sine * station_frame.cos_λ + tau.cosine * station_frame.sin_λ;
+
+	double cos_theta[DIURNAL_BAND_ROWS], sin_theta[DIURNAL_BAND_ROWS];
+	for(unsigned int row = 0; row < DIURNAL_BAND_ROWS; row++)
 	{
-		double thetaf = (tau + IERS_conversion[row][0] * s + IERS_conversion[row][1] * h
-			+ IERS_conversion[row][2] * p + IERS_conversion[row][3] * zns + IERS_conversion[row][4] * ps)
-			* RADIANS_PER_DEGREE;
-		double dr = IERS_conversion[row][5] * 2.0 * sin_ϕ * cos_ϕ * sin(thetaf + Z_latitude) + IERS_conversion[row][6]
-			* 2.0 * sin_ϕ * cos_ϕ * cos(thetaf + Z_latitude);
-		double dn = IERS_conversion[row][7] * (pow(cos_ϕ, 2) - pow(sin_ϕ, 2)) * sin(thetaf + Z_latitude) + 
-			IERS_conversion[row][8] * (pow(cos_ϕ, 2) - pow(sin_ϕ, 2)) * cos(thetaf + Z_latitude);
-		double de = IERS_conversion[row][7] * sin_ϕ * cos(thetaf + Z_latitude)
-			- IERS_conversion[row][8] * sin_ϕ * sin(thetaf + Z_latitude);
-		correction[X] += dr * cos_latitude * cos_ϕ - de * sin_latitude - dn * sin_ϕ * cos_latitude;
-		correction[Y] += dr * sin_latitude * cos_ϕ + de * cos_latitude - dn * sin_ϕ * sin_latitude;
-		correction[Z] += dr * sin_ϕ + dn * cos_ϕ;
+		double cosine = cos_tau_zla, sine = sin_tau_zla;
+		for(unsigned int argument = 0; argument < 5; argument++)
+		{
+			int multiple = DIURNAL_BAND_MULTIPLIERS[argument][row] + FundamentalArguments::MULTIPLE;
+			double multiple_cosine = fundamental_arguments.multiple_cosine[argument][multiple];
+			double multiple_sine = fundamental_arguments.multiple_sine[argument][multiple];
+			double next_cosine = cosine * multiple_cosine - sine * multiple_sine;
+			sine = sine * multiple_cosine + cosine * multiple_sine;
+			cosine = next_cosine;
+		}
+		cos_theta[row] = cosine;
+		sin_theta[row] = sine;
 	}
 
+	// The latitude factors & the up/east/north directions are the same for every row, so they are applied once to the
+	//  sums instead of once per row.
+	double dr = 0.0, dn = 0.0, de = 0.0;
+	for(unsigned int row = 0; row < DIURNAL_BAND_ROWS; row++)
+	{
+		dr += DIURNAL_BAND_AMPLITUDES[0][row] * sin_theta[row] + DIURNAL_BAND_AMPLITUDES[1][row] * cos_theta[row];
+		dn += DIURNAL_BAND_AMPLITUDES[2][row] * sin_theta[row] + DIURNAL_BAND_AMPLITUDES[3][row] * cos_theta[row];
+		de += DIURNAL_BAND_AMPLITUDES[2][row] * cos_theta[row] - DIURNAL_BAND_AMPLITUDES[3][row] * sin_theta[row];
+	}
+	dr *= sin_2ϕ;
+	dn *= cos_2ϕ;
+	de *= sin_ϕ;
+
+	Coordinate<double> correction(
+		dr * station_frame.up[X] + de * station_frame.east[X] + dn * station_frame.north[X],
+		dr * station_frame.up[Y] + de * station_frame.east[Y] + dn * station_frame.north[Y],
+		dr * station_frame.up[Z] + dn * station_frame.north[Z]
+	);
+
 	return correction / 1000.0;
 }
 
 
-Coordinate<double> Geolocation::second_step_longitudinal_correction(Coordinate<double>& geo_coordinate,
-	double terrestrial_time_hours, double terrestrial_time_years
+Coordinate<double> Geolocation::second_step_longitudinal_correction(const StationFrame& station_frame,
+	const EpochContext& epoch_context
 )
 /*
 solid.f [LN 509]
 ```
 |      subroutine step2lon(xsta,fhr,t,xcorsta)
 ```
-xsta — geo_coordinate
-fhr — terrestrial_time_hours
-t — terrestrial_time_years
+xsta — station_frame
+fhr, t — epoch_context (s, h, p, zns & ps are evaluated & reduced in its `FundamentalArguments` [solid.f LN 528–554])
 xcorsta — [returned]
 */
 {
-	/*
-	solid.f [LN 516–526]
-	```
-	|*** cf. table 7.5b of IERS conventions 2003 (TN.32, pg.82)
-	|*** columns are s,h,p,N',ps, dR(ip),dT(ip),dR(op),dT(op)
-	|*** IERS cols.= s,h,p,N',ps, dR(ip),dR(op),dT(ip),dT(op)
-	|*** units of mm
-	|
-	|      data ((datdi(i,j),i=1,9),j=1,5)/
-	|     *   0, 0, 0, 1, 0,   0.47, 0.23, 0.16, 0.07,
-	|     *   0, 2, 0, 0, 0,  -0.20,-0.12,-0.11,-0.05,
-	|     *   1, 0,-1, 0, 0,  -0.11,-0.08,-0.09,-0.04,
-	|     *   2, 0, 0, 0, 0,  -0.13,-0.11,-0.15,-0.07,
-	|     *   2, 0, 0, 1, 0,  -0.05,-0.05,-0.06,-0.03/
-	*/
-	double IERS_conversion[5][9] = {
-		{0.0, 0.0,  0.0, 1.0, 0.0,  0.47,  0.23,  0.16,  0.07},
-		{0.0, 2.0,  0.0, 0.0, 0.0, -0.20, -0.12, -0.11, -0.05},
-		{1.0, 0.0, -1.0, 0.0, 0.0, -0.11, -0.08, -0.09, -0.04},
-		{2.0, 0.0,  0.0, 0.0, 0.0, -0.13, -0.11, -0.15, -0.07},
-		{2.0, 0.0,  0.0, 1.0, 0.0, -0.05, -0.05, -0.06, -0.03}
-	};
-
-	/*
-	solid.f [LN 528–540]
-	```
-	|      s=218.31664563d0+481267.88194d0*t-0.0014663889d0*t*t
-	|     * +0.00000185139d0*t**3
-	|      pr=1.396971278*t+0.000308889*t*t+0.000000021*t**3
-	|     * +0.000000007*t**4
-	|      s=s+pr
-	|      h=280.46645d0+36000.7697489d0*t+0.00030322222d0*t*t
-	|     * +0.000000020*t**3-0.00000000654*t**4
-	|      p=83.35324312d0+4069.01363525d0*t-0.01032172222d0*t*t
-	|     * -0.0000124991d0*t**3+0.00000005263d0*t**4
-	|      zns=234.95544499d0 +1934.13626197d0*t-0.00207561111d0*t*t
-	|     * -0.00000213944d0*t**3+0.00000001650d0*t**4
-	|      ps=282.93734098d0+1.71945766667d0*t+0.00045688889d0*t*t
-	|     * -0.00000001778d0*t**3-0.00000000334d0*t**4
-	```
-	*/
-	double s_less_pr = 218.31664563 + 481267.88194 * terrestrial_time_years - 0.0014663889 * terrestrial_time_years
-		* terrestrial_time_years + 0.00000185139 * pow(terrestrial_time_years, 3);
-	double pr = 1.396971278 * terrestrial_time_years + 0.000308889 * terrestrial_time_years
-		* terrestrial_time_years + 0.000000021 * pow(terrestrial_time_years, 3) + 0.000000007
-		* pow(terrestrial_time_years, 4);
-	double h_part = 280.46645 + 36000.7697489 * terrestrial_time_years + 0.00030322222 * terrestrial_time_years
-		* terrestrial_time_years + 0.000000020 * pow(terrestrial_time_years, 3) - 0.00000000654
-		* pow(terrestrial_time_years, 4);
-	double p_part = 83.35324312 + 4069.01363525 * terrestrial_time_years - 0.01032172222 * terrestrial_time_years
-		* terrestrial_time_years - 0.0000124991 * pow(terrestrial_time_years, 3) + 0.00000005263
-		* pow(terrestrial_time_years, 4);
-	double zns_part = 234.95544499  + 1934.13626197 * terrestrial_time_years - 0.00207561111
-		* terrestrial_time_years * terrestrial_time_years - 0.00000213944 * pow(terrestrial_time_years, 3)
-		+ 0.00000001650 * pow(terrestrial_time_years, 4);
-	double ps_part = 282.93734098 + 1.71945766667 * terrestrial_time_years + 0.00045688889 * terrestrial_time_years
-		* terrestrial_time_years - 0.00000001778 * pow(terrestrial_time_years, 3) - 0.00000000334
-		* pow(terrestrial_time_years, 4);
-
 	/*
 	solid.f [LN 541–545]
 	```
@@ -1011,47 +1013,12 @@ xcorsta — [returned]
 	|      cosla=xsta(1)/cosphi/rsta
 	|      sinla=xsta(2)/cosphi/rsta
 	```
-	rsta — geo_distance
+	rsta — station_frame.distance (the station terms are all derived once, in StationFrame)
 	sinphi — sin_ϕ
 	cosphi — cos_ϕ
-	cosla — cos_latitude
-	sinla — sin_latitude
 	*/
-	double geo_distance = geo_coordinate.distance();
-	double sin_ϕ = geo_coordinate[Z] / geo_distance;
-	double cos_ϕ = sqrt(pow(geo_coordinate[X], 2) + pow(geo_coordinate[Y], 2)) / geo_distance;
-	double cos_latitude = geo_coordinate[X] / cos_ϕ / geo_distance;
-	double sin_latitude = geo_coordinate[Y] / cos_ϕ / geo_distance;
-
-	/*
-	solid.f [LN 547–554]
-	```
-	|*** reduce angles to between 0 and 360
-	|
-	|      s=  dmod(  s,360.d0)
-	|***** tau=dmod(tau,360.d0)       !*** tau not used here--09jul28
-	|      h=  dmod(  h,360.d0)
-	|      p=  dmod(  p,360.d0)
-	|      zns=dmod(zns,360.d0)
-	|      ps= dmod( ps,360.d0)
-	```
-	*/
-	double s = std::fmod(s_less_pr + pr, 360.0);
-	double h = std::fmod(h_part, 360.0);
-	double p = std::fmod(p_part, 360.0);
-	double zns = std::fmod(zns_part, 360.0);
-	double ps = std::fmod(ps_part, 360.0);
-
-	/*
-	solid.f [LN 556...560]
-	```
-	|      dr_tot=0.d0
-	⋮
-	|      enddo
-	```
-	*/
-	double dr_tot = 0, dn_tot = 0;
-	Coordinate<double> partial_correction;
+	double radial_latitude_factor = (3.0 * station_frame.sin_squared_ϕ - 1.0) / 2.0;
+	double sin_2ϕ = station_frame.sin_2ϕ;
 
 	/*
 	solid.f [LN 562–584]
@@ -1080,22 +1047,33 @@ xcorsta — [returned]
 	|        xcorsta(i)=xcorsta(i)/1000.d0
 	|      enddo
 	```
+	As in `second_step_diurnal_band_correction`, cos & sin of thetaf come from the arguments' precomputed multiples.
 	*/
-	for(unsigned int x = 0; x < 5; x++)
+	const FundamentalArguments& fundamental_arguments = epoch_context.fundamental_arguments;
+	double dr = 0.0, dn = 0.0;
+	for(unsigned int row = 0; row < LONG_PERIOD_BAND_ROWS; row++)
 	{
-		double thetaf = (IERS_conversion[x][0] * s + IERS_conversion[x][1] * h + IERS_conversion[x][2] * p + 
-			IERS_conversion[x][3] * zns + IERS_conversion[x][4] * ps) * RADIANS_PER_DEGREE;
-		double dr = IERS_conversion[x][5] * (3.0 * pow(sin_ϕ, 2) - 1.0) / 2.0 * cos(thetaf) + 
-			IERS_conversion[x][7] * (3.0 * pow(sin_ϕ, 2) - 1.0) / 2.0 * sin(thetaf);
-		double dn = IERS_conversion[x][6] * (cos_ϕ * sin_ϕ * 2.0) * cos(thetaf) + IERS_conversion[x][8]
-			* (cos_ϕ * sin_ϕ * 2.0) * sin(thetaf);
-		dr_tot = dr_tot + dr;
-		dn_tot = dn_tot + dn;
-
-		partial_correction[X] += dr * cos_latitude * cos_ϕ - 0.0 * sin_latitude - dn * sin_ϕ * cos_latitude;
-		partial_correction[Y] += dr * sin_latitude * cos_ϕ + 0.0 * cos_latitude - dn * sin_ϕ * sin_latitude;
-		partial_correction[Z] += dr * sin_ϕ + dn * cos_ϕ;
+		double cos_theta = 1.0, sin_theta = 0.0;
+		for(unsigned int argument = 0; argument < 5; argument++)
+		{
+			int multiple = LONG_PERIOD_BAND_MULTIPLIERS[argument][row] + FundamentalArguments::MULTIPLE;
+			double multiple_cosine = fundamental_arguments.multiple_cosine[argument][multiple];
+			double multiple_sine = fundamental_arguments.multiple_sine[argument][multiple];
+			double next_cosine = cos_theta * multiple_cosine - sin_theta * multiple_sine;
+			sin_theta = sin_theta * multiple_cosine + cos_theta * multiple_sine;
+			cos_theta = next_cosine;
+		}
+		dr += LONG_PERIOD_BAND_AMPLITUDES[0][row] * cos_theta + LONG_PERIOD_BAND_AMPLITUDES[2][row] * sin_theta;
+		dn += LONG_PERIOD_BAND_AMPLITUDES[1][row] * cos_theta + LONG_PERIOD_BAND_AMPLITUDES[3][row] * sin_theta;
 	}
+	dr *= radial_latitude_factor;
+	dn *= sin_2ϕ;
+
+	Coordinate<double> partial_correction(
+		dr * station_frame.up[X] + dn * station_frame.north[X],
+		dr * station_frame.up[Y] + dn * station_frame.north[Y],
+		dr * station_frame.up[Z] + dn * station_frame.north[Z]
+	);
 
 	return partial_correction / 1000;
 }
@@ -0,0 +1,267 @@
+
+
+#include "Geolocation.hpp"
+
+
+#include <cmath>
+#include <vector>
+
+
+#include "ChebyshevEphemeris.hpp"
+#include "Coordinate.hpp"
+#include "EphemerisKernels.hpp"
+#include "EpochContext.hpp"
+#include "JulianDate.hpp"
+#include "StageTimer.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+#include "UniformEpochs.hpp"
+
+
+const std::size_t Geolocation::SERIES_BLOCK;
+const std::size_t Geolocation::CHEBYSHEV_SAMPLES_PER_DAY = 288;
+
+
+void Geolocation::tide_series(unsigned int modified_julian_date, double fractional_modified_julian_date,
+	double step_seconds, std::size_t count, double* x, double* y, double* z
+)
+/*
+solid.f [LN 77–98]
+```
+|      tdel2=1.d0/60.d0/24.d0                           !*** 1 minute steps
+|      do iloop=0,60*24
+|        lflag=.false.                           !*** false means flag not raised
+|        call sunxyz (mjd,fmjd,rsun,lflag)                   !*** mjd/fmjd in UTC
+|        call moonxyz(mjd,fmjd,rmoon,lflag)                  !*** mjd/fmjd in UTC
+|        call detide (xsta,mjd,fmjd,rsun,rmoon,etide,lflag)  !*** mjd/fmjd in UTC
+|        xt = etide(1)
+|        yt = etide(2)
+|        zt = etide(3)
+⋮
+|        fmjd=fmjd+tdel2
+|        fmjd=(idnint(fmjd*86400.d0))/86400.d0      !*** force 1 sec. granularity
+|      enddo
+```
+Evaluates `count` tide displacements (ECEF, meters) starting at the UTC epoch `modified_julian_date` +
+`fractional_modified_julian_date` and advancing `step_seconds` per sample. The results are written to the caller-owned
+structure-of-arrays `x`, `y` & `z`, each of which must hold `count` values.
+
+Nothing about the station changes between samples, so its frame (ECEF position, latitude & longitude terms) is derived
+ once for the whole series instead of once per `tide()` call. The samples' `EpochContext`s come from `UniformEpochs`,
+ which advances their angles by rotation instead of `sin`/`cos`; the sun & moon series are evaluated `SERIES_BLOCK`
+ epochs at a time by the vectorized `EphemerisKernels` (or by a `ChebyshevEphemeris` fitted to them, for series of at
+ least `CHEBYSHEV_SAMPLES_PER_DAY`), then rotated to ECEF per sample by the context's Greenwich hour angle.
+*/
+{
+	StationFrame station_frame(*this);
+	UniformEpochs uniform_epochs(modified_julian_date, fractional_modified_julian_date, step_seconds);
+	std::unique_ptr<ChebyshevEphemeris> chebyshev_ephemeris = series_ephemeris(uniform_epochs, count);
+	tide_series_blocks(station_frame, uniform_epochs, chebyshev_ephemeris.get(), 0, count, x, y, z);
+}
+
+
+void Geolocation::tide_series(unsigned int modified_julian_date, double fractional_modified_julian_date,
+	double step_seconds, std::size_t count, double* x, double* y, double* z, ThreadPool& thread_pool
+)
+/*
+`tide_series` with the samples split into chunks that `thread_pool` evaluates concurrently; the output is identical to
+ the serial call's.
+*/
+{
+	UniformEpochs uniform_epochs(modified_julian_date, fractional_modified_julian_date, step_seconds);
+	std::unique_ptr<ChebyshevEphemeris> chebyshev_ephemeris = series_ephemeris(uniform_epochs, count);
+	tide_series(uniform_epochs, chebyshev_ephemeris.get(), 0, count, x, y, z, thread_pool);
+}
+
+
+void Geolocation::tide_series(const UniformEpochs& uniform_epochs, const ChebyshevEphemeris* chebyshev_ephemeris,
+	std::size_t first, std::size_t count, double* x, double* y, double* z, ThreadPool& thread_pool
+)
+/*
+Samples [`first`, `first` + `count`) of the series of `uniform_epochs`, written to `x`, `y` & `z` from their start, with
+ the sun & moon of `chebyshev_ephemeris` (from `series_ephemeris()` for the whole series) when there is one. A series
+ evaluated a part at a time this way, e.g. to bound the memory it needs, is identical to it evaluated at once.
+The part is split into chunks that `thread_pool` evaluates concurrently, each a multiple of `SERIES_BLOCK` (itself a
+ multiple of the `UniformEpochs` anchor interval), so each sample goes through exactly the same anchors & kernel
+ blocks as in the serial call and the output is identical to it. Each chunk writes only its own range of `x`, `y` &
+ `z`. There are several chunks per thread, so that threads that finish early can steal from the rest.
+*/
+{
+	static_assert(SERIES_BLOCK % UniformEpochs::MAX_ANCHOR_INTERVAL == 0,
+		"Chunks must start on anchors, so that they match the serial series");
+
+	StationFrame station_frame(*this);
+	const std::size_t CHUNKS_PER_THREAD = 8;
+	std::size_t blocks = (count + SERIES_BLOCK - 1) / SERIES_BLOCK;
+	std::size_t chunk_blocks = (blocks + thread_pool.size() * CHUNKS_PER_THREAD - 1)
+		/ (thread_pool.size() * CHUNKS_PER_THREAD);
+	std::size_t chunk = (chunk_blocks == 0 ? 1 : chunk_blocks) * SERIES_BLOCK;
+
+	thread_pool.run((count + chunk - 1) / chunk,
+		[&](std::size_t index)
+		{
+			std::size_t offset = index * chunk;
+			std::size_t chunk_count = count - offset < chunk ? count - offset : chunk;
+			tide_series_blocks(station_frame, uniform_epochs, chebyshev_ephemeris, first + offset, chunk_count,
+				x + offset, y + offset, z + offset);
+		}
+	);
+}
+
+
+std::unique_ptr<ChebyshevEphemeris> Geolocation::series_ephemeris(const UniformEpochs& uniform_epochs,
+	std::size_t count
+)
+/*
+A `ChebyshevEphemeris` over the UTC days of the series when it has at least `CHEBYSHEV_SAMPLES_PER_DAY` for every day
+ fitted (its days & a day of margin either side), otherwise none.
+*/
+{
+	if(count == 0)
+	{
+		return nullptr;
+	}
+	unsigned int first_day = uniform_epochs.julian_date(0).modified_julian_date();
+	unsigned int last_day = uniform_epochs.julian_date(count - 1).modified_julian_date();
+	if(last_day < first_day || count < CHEBYSHEV_SAMPLES_PER_DAY * (last_day - first_day + 3))
+	{
+		return nullptr;
+	}
+	return std::unique_ptr<ChebyshevEphemeris>(new ChebyshevEphemeris(first_day, last_day - first_day + 1));
+}
+
+
+void Geolocation::series_coordinates(const EpochContext* epoch_contexts, std::size_t count,
+	const ChebyshevEphemeris* chebyshev_ephemeris, Coordinate<double>* solar_coordinates,
+	Coordinate<double>* lunar_coordinates
+)
+/*
+The sun & moon (ECEF, meters) of `count` epochs of a series: from `chebyshev_ephemeris` when there is one, otherwise
+ from the `EphemerisKernels` `SERIES_BLOCK` epochs per call, then rotated by each context's Greenwich hour angle. Any
+ station's `tide()` at these epochs can use them.
+*/
+{
+	double terrestrial_time[SERIES_BLOCK];
+	double solar_x[SERIES_BLOCK], solar_y[SERIES_BLOCK], solar_z[SERIES_BLOCK];
+	double lunar_x[SERIES_BLOCK], lunar_y[SERIES_BLOCK], lunar_z[SERIES_BLOCK];
+
+	for(std::size_t block = 0; block < count; block += SERIES_BLOCK)
+	{
+		std::size_t block_count = count - block < SERIES_BLOCK ? count - block : SERIES_BLOCK;
+		for(std::size_t index = 0; index < block_count; index++)
+		{
+			terrestrial_time[index] = epoch_contexts[block + index].julian_centuries;
+		}
+
+		SOLID_EARTH_TIDE_STAGE_COUNT(stage_timer, SUN, block_count);
+		if(chebyshev_ephemeris)
+		{
+			for(std::size_t index = 0; index < block_count; index++)
+			{
+				Coordinate<double> solar = chebyshev_ephemeris->sun_inertial_coordinates(terrestrial_time[index]);
+				solar_x[index] = solar[X];
+				solar_y[index] = solar[Y];
+				solar_z[index] = solar[Z];
+			}
+		}
+		else
+		{
+			EphemerisKernels::sun_inertial_coordinates(terrestrial_time, block_count, solar_x, solar_y, solar_z);
+		}
+		SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, MOON);
+		if(chebyshev_ephemeris)
+		{
+			for(std::size_t index = 0; index < block_count; index++)
+			{
+				Coordinate<double> lunar = chebyshev_ephemeris->moon_inertial_coordinates(terrestrial_time[index]);
+				lunar_x[index] = lunar[X];
+				lunar_y[index] = lunar[Y];
+				lunar_z[index] = lunar[Z];
+			}
+		}
+		else
+		{
+			EphemerisKernels::moon_inertial_coordinates(terrestrial_time, block_count, lunar_x, lunar_y, lunar_z);
+		}
+		SOLID_EARTH_TIDE_STAGE_STOP(stage_timer);
+
+		for(std::size_t index = 0; index < block_count; index++)
+		{
+			const EpochContext& epoch_context = epoch_contexts[block + index];
+			solar_coordinates[block + index] = Coordinate<double>(solar_x[index], solar_y[index], solar_z[index])
+				.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+			lunar_coordinates[block + index] = Coordinate<double>(lunar_x[index], lunar_y[index], lunar_z[index])
+				.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+		}
+	}
+}
+
+
+void Geolocation::tide_series_blocks(const StationFrame& station_frame, const UniformEpochs& uniform_epochs,
+	const ChebyshevEphemeris* chebyshev_ephemeris, std::size_t first, std::size_t count, double* x, double* y, double* z
+)
+/*
+Samples [`first`, `first` + `count`) of a series, written to `x`, `y` & `z` from their start, `SERIES_BLOCK` at a time.
+*/
+{
+	std::vector<EpochContext> epoch_contexts;
+	epoch_contexts.reserve(SERIES_BLOCK);
+	Coordinate<double> solar_coordinates[SERIES_BLOCK], lunar_coordinates[SERIES_BLOCK];
+
+	for(std::size_t block = 0; block < count; block += SERIES_BLOCK)
+	{
+		std::size_t block_count = count - block < SERIES_BLOCK ? count - block : SERIES_BLOCK;
+		{
+			SOLID_EARTH_TIDE_STAGE_COUNT(stage_timer, TIME_SCALES, block_count);
+			epoch_contexts.clear();
+			uniform_epochs.epochs(first + block, block_count, epoch_contexts);
+		}
+		series_coordinates(epoch_contexts.data(), block_count, chebyshev_ephemeris, solar_coordinates,
+			lunar_coordinates);
+
+		for(std::size_t index = 0; index < block_count; index++)
+		{
+			Coordinate<double> displacement = tide(epoch_contexts[index], station_frame, solar_coordinates[index],
+				lunar_coordinates[index]);
+			x[block + index] = displacement[X];
+			y[block + index] = displacement[Y];
+			z[block + index] = displacement[Z];
+		}
+	}
+}
+
+
+void Geolocation::local_horizon(std::size_t count, const double* x, const double* y, const double* z, double* north,
+	double* east, double* up
+)
+/*
+solid.f [LN 989–1003]
+```
+|      subroutine rge(gla,glo,u,v,w,x,y,z)
+|
+|*** given a rectangular cartesian system (x,y,z)
+|*** compute a geodetic h cartesian sys   (u,v,w)
+⋮
+|      u=-sb*cl*x-sb*sl*y+cb*z
+|      v=-   sl*x+   cl*y
+|      w= cb*cl*x+cb*sl*y+sb*z
+```
+Rotates `count` ECEF displacements (as `tide_series` writes them) to the station's geodetic north, east & up, with the
+ sines & cosines taken once for the series. The outputs may be the inputs, e.g. `north` = `x`.
+*/
+{
+	double sin_latitude = sin(_latitude);
+	double cos_latitude = cos(_latitude);
+	double sin_longitude = sin(_longitude);
+	double cos_longitude = cos(_longitude);
+
+	for(std::size_t index = 0; index < count; index++)
+	{
+		double x_index = x[index], y_index = y[index], z_index = z[index];
+		north[index] = -sin_latitude * cos_longitude * x_index - sin_latitude * sin_longitude * y_index
+			+ cos_latitude * z_index;
+		east[index] = -sin_longitude * x_index + cos_longitude * y_index;
+		up[index] = cos_latitude * cos_longitude * x_index + cos_latitude * sin_longitude * y_index
+			+ sin_latitude * z_index;
+	}
+}
@@ -0,0 +1,380 @@
+
+
+#include "JobPlanner.hpp"
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+
+#include "ChebyshevEphemeris.hpp"
+#include "Coordinate.hpp"
+#include "EpochContext.hpp"
+#include "StageTimer.hpp"
+#include "ThreadPool.hpp"
+#include "UniformEpochs.hpp"
+
+
+const double JobPlanner::EPOCH_RESOLUTION_SECONDS = 1e-6;
+const std::size_t JobPlanner::CHUNK_VALUES = 1 << 20;
+const std::size_t JobPlanner::GROUP_STATIONS = 64;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+JobPlanner::JobPlanner()
+: _first_modified_julian_date{std::numeric_limits<unsigned int>::max()}
+{}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+std::size_t JobPlanner::station(double latitude_degrees, double longitude_degrees, double height_meters)
+/*
+The index of the station at these coordinates, added if it is new.
+*/
+{
+	std::pair<std::map<Coordinates, std::size_t>::iterator, bool> inserted = _station_indices.insert(
+		std::make_pair(Coordinates(latitude_degrees, longitude_degrees, height_meters), _latitudes.size()));
+	if(!inserted.second)
+	{
+		return inserted.first->second;
+	}
+
+	_latitudes.push_back(latitude_degrees);
+	_longitudes.push_back(longitude_degrees);
+	_heights.push_back(height_meters);
+	_geolocations.push_back(Geolocation(latitude_degrees, longitude_degrees, height_meters));
+	_station_frames.push_back(StationFrame(_geolocations.back()));
+	return _latitudes.size() - 1;
+}
+
+
+std::size_t JobPlanner::request(std::size_t station, unsigned int modified_julian_date, double start_seconds,
+	double step_seconds, std::size_t count
+)
+/*
+Adds a series of `count` UTC epochs, `step_seconds` apart from `start_seconds` after the start of
+ `modified_julian_date`, at `station` (from `station()`). Returns the index that `run()` hands its samples with.
+*/
+{
+	if(station >= _latitudes.size())
+	{
+		throw std::runtime_error("Request for an unknown station");
+	}
+	if(!(step_seconds > 0.0))
+	{
+		throw std::runtime_error("Series step must be a positive number of seconds");
+	}
+
+	_requests.push_back(Request{station, modified_julian_date, start_seconds, step_seconds, count});
+	_first_modified_julian_date = std::min(_first_modified_julian_date, modified_julian_date);
+	return _requests.size() - 1;
+}
+
+
+std::size_t JobPlanner::stations() const
+{
+	return _latitudes.size();
+}
+
+
+std::size_t JobPlanner::runs() const
+{
+	return _runs.size();
+}
+
+
+std::size_t JobPlanner::epochs() const
+{
+	std::size_t epochs = 0;
+	for(const std::vector<std::size_t>& group : _groups)
+	{
+		epochs += _runs[group.front()].count;
+	}
+	return epochs;
+}
+
+
+std::size_t JobPlanner::evaluations() const
+{
+	std::size_t evaluations = 0;
+	for(const Run& run : _runs)
+	{
+		evaluations += run.count;
+	}
+	return evaluations;
+}
+
+
+std::size_t JobPlanner::samples() const
+{
+	std::size_t samples = 0;
+	for(const Request& request : _requests)
+	{
+		samples += request.count;
+	}
+	return samples;
+}
+
+
+void JobPlanner::run(ThreadPool& thread_pool, const Output& output)
+/*
+Plans the runs of every request added so far, then evaluates them a group at a time & hands each chunk to `output`.
+ Only one group's chunk of results is held at a time.
+*/
+{
+	plan();
+	for(const std::vector<std::size_t>& group : _groups)
+	{
+		evaluate(group, thread_pool, output);
+	}
+}
+
+
+std::int64_t JobPlanner::epoch_key(unsigned int modified_julian_date, double seconds) const
+/*
+The UTC epoch `seconds` after the start of `modified_julian_date`, in `EPOCH_RESOLUTION_SECONDS` from the start of
+ `_first_modified_julian_date`.
+*/
+{
+	double from_first = (static_cast<double>(modified_julian_date) - _first_modified_julian_date) * 86400.0 + seconds;
+	return std::llround(from_first / EPOCH_RESOLUTION_SECONDS);
+}
+
+
+void JobPlanner::plan()
+/*
+Sorts the requests by station, step & start, so that each station's runs of a step are complete before any coarser
+ request looks for one to read from, & a request at one step can only extend the last run it touches. Then sorts the
+ runs by their epochs into groups. Planning is linear in the requests (& in the runs of each station), not the samples.
+*/
+{
+	_runs.clear();
+	_groups.clear();
+
+	std::vector<std::int64_t> start_keys(_requests.size()), step_keys(_requests.size());
+	for(std::size_t index = 0; index < _requests.size(); index++)
+	{
+		const Request& request = _requests[index];
+		start_keys[index] = epoch_key(request.modified_julian_date, request.start_seconds);
+		step_keys[index] = std::max<std::int64_t>(std::llround(request.step_seconds / EPOCH_RESOLUTION_SECONDS), 1);
+	}
+
+	std::vector<std::size_t> order(_requests.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(),
+		[&](std::size_t left, std::size_t right)
+		{
+			return std::make_tuple(_requests[left].station, step_keys[left], _requests[left].step_seconds,
+				start_keys[left], left) < std::make_tuple(_requests[right].station, step_keys[right],
+				_requests[right].step_seconds, start_keys[right], right);
+		}
+	);
+
+	std::vector<std::vector<std::size_t>> station_runs(_latitudes.size());
+	for(std::size_t index : order)
+	{
+		const Request& request = _requests[index];
+		if(request.count == 0)
+		{
+			continue;
+		}
+
+		// The latest run first, as a request at a run's step can only touch the last one
+		bool placed = false;
+		std::vector<std::size_t>& runs = station_runs[request.station];
+		for(std::vector<std::size_t>::reverse_iterator entry = runs.rbegin(); entry != runs.rend() && !placed; entry++)
+		{
+			Run& run = _runs[*entry];
+			double run_step_seconds = _requests[run.request].step_seconds;
+			std::int64_t offset_key = start_keys[index] - run.start_key;
+			if(offset_key < 0 || offset_key % run.step_key != 0)
+			{
+				continue;
+			}
+
+			std::size_t offset = offset_key / run.step_key;
+			if(request.step_seconds == run_step_seconds && offset <= run.count)
+			{
+				run.count = std::max(run.count, offset + request.count);
+				run.requests.push_back(index);
+				run.offsets.push_back(offset);
+				run.strides.push_back(1);
+				placed = true;
+			}
+			else if(step_keys[index] % run.step_key == 0)
+			{
+				std::size_t stride = step_keys[index] / run.step_key;
+				std::size_t last = offset + (request.count - 1) * stride;
+				if(request.step_seconds == stride * run_step_seconds && last < run.count)
+				{
+					run.requests.push_back(index);
+					run.offsets.push_back(offset);
+					run.strides.push_back(stride);
+					placed = true;
+				}
+			}
+		}
+		if(!placed)
+		{
+			runs.push_back(_runs.size());
+			_runs.push_back(Run{request.station, index, start_keys[index], step_keys[index], request.count,
+				std::vector<std::size_t>(1, index), std::vector<std::size_t>(1, 0), std::vector<std::size_t>(1, 1)});
+		}
+	}
+
+	std::vector<std::size_t> run_order(_runs.size());
+	std::iota(run_order.begin(), run_order.end(), 0);
+	std::sort(run_order.begin(), run_order.end(),
+		[&](std::size_t left, std::size_t right)
+		{
+			const Run& left_run = _runs[left];
+			const Run& right_run = _runs[right];
+			return std::make_tuple(left_run.start_key, left_run.step_key, _requests[left_run.request].step_seconds,
+				left_run.count, left_run.station) < std::make_tuple(right_run.start_key, right_run.step_key,
+				_requests[right_run.request].step_seconds, right_run.count, right_run.station);
+		}
+	);
+	for(std::size_t index : run_order)
+	{
+		const Run& run = _runs[index];
+		bool joins = false;
+		if(!_groups.empty() && _groups.back().size() < GROUP_STATIONS)
+		{
+			const Run& group_run = _runs[_groups.back().front()];
+			joins = run.start_key == group_run.start_key && run.step_key == group_run.step_key
+				&& _requests[run.request].step_seconds == _requests[group_run.request].step_seconds
+				&& run.count == group_run.count;
+		}
+		if(!joins)
+		{
+			_groups.push_back(std::vector<std::size_t>());
+		}
+		_groups.back().push_back(index);
+	}
+}
+
+
+void JobPlanner::evaluate(const std::vector<std::size_t>& group, ThreadPool& thread_pool, const Output& output)
+/*
+The runs of `group`, in chunks of about `CHUNK_VALUES` station epochs (a multiple of `Geolocation::SERIES_BLOCK`
+ epochs). A single station's chunk is `Geolocation::tide_series`; otherwise each `ThreadPool` task builds the contexts,
+ sun & moon of `SERIES_BLOCK` epochs as `tide_series` does, & every station of the group reuses them.
+*/
+{
+	const Run& first_run = _runs[group.front()];
+	const Request& request = _requests[first_run.request];
+	const std::size_t SERIES_BLOCK = Geolocation::SERIES_BLOCK;
+	std::size_t count = first_run.count;
+	UniformEpochs uniform_epochs(request.modified_julian_date, request.start_seconds / 86400.0, request.step_seconds);
+	std::unique_ptr<ChebyshevEphemeris> chebyshev_ephemeris = Geolocation::series_ephemeris(uniform_epochs, count);
+
+	std::size_t chunk_blocks = CHUNK_VALUES / group.size() / SERIES_BLOCK;
+	std::size_t chunk = (chunk_blocks == 0 ? 1 : chunk_blocks) * SERIES_BLOCK;
+	std::size_t width = std::min(chunk, count);  // Of each station's part of the chunk
+	std::vector<double> x(group.size() * width), y(group.size() * width), z(group.size() * width);
+
+	for(std::size_t first = 0; first < count; first += chunk)
+	{
+		std::size_t chunk_count = std::min(chunk, count - first);
+		if(group.size() == 1)
+		{
+			_geolocations[first_run.station].tide_series(uniform_epochs, chebyshev_ephemeris.get(), first, chunk_count,
+				x.data(), y.data(), z.data(), thread_pool);
+		}
+		else
+		{
+			thread_pool.run((chunk_count + SERIES_BLOCK - 1) / SERIES_BLOCK,
+				[&](std::size_t block)
+				{
+					std::size_t offset = block * SERIES_BLOCK;
+					std::size_t block_count = std::min(SERIES_BLOCK, chunk_count - offset);
+					std::vector<EpochContext> epoch_contexts;
+					epoch_contexts.reserve(block_count);
+					{
+						SOLID_EARTH_TIDE_STAGE_COUNT(stage_timer, TIME_SCALES, block_count);
+						uniform_epochs.epochs(first + offset, block_count, epoch_contexts);
+					}
+					std::vector<Coordinate<double>> solar_coordinates(block_count), lunar_coordinates(block_count);
+					Geolocation::series_coordinates(epoch_contexts.data(), block_count, chebyshev_ephemeris.get(),
+						solar_coordinates.data(), lunar_coordinates.data());
+
+					for(std::size_t member = 0; member < group.size(); member++)
+					{
+						std::size_t station = _runs[group[member]].station;
+						std::size_t start = member * width + offset;
+						for(std::size_t index = 0; index < block_count; index++)
+						{
+							Coordinate<double> displacement = _geolocations[station].tide(epoch_contexts[index],
+								_station_frames[station], solar_coordinates[index], lunar_coordinates[index]);
+							x[start + index] = displacement[X];
+							y[start + index] = displacement[Y];
+							z[start + index] = displacement[Z];
+						}
+					}
+				}
+			);
+		}
+
+		for(std::size_t member = 0; member < group.size(); member++)
+		{
+			std::size_t start = member * width;
+			deliver(_runs[group[member]], first, chunk_count, x.data() + start, y.data() + start, z.data() + start,
+				output);
+		}
+	}
+}
+
+
+void JobPlanner::deliver(const Run& run, std::size_t first, std::size_t count, const double* x, const double* y,
+	const double* z, const Output& output
+)
+/*
+Hands samples [`first`, `first` + `count`) of `run`, held in `x`, `y` & `z` from their start, to each request that
+ reads it: as they are for a request at the run's step, gathered for one that reads every n-th sample.
+*/
+{
+	std::vector<double> gathered_x, gathered_y, gathered_z;
+	for(std::size_t member = 0; member < run.requests.size(); member++)
+	{
+		std::size_t request = run.requests[member];
+		std::size_t offset = run.offsets[member];
+		std::size_t stride = run.strides[member];
+		if(first + count <= offset)
+		{
+			continue;
+		}
+
+		// The request's samples whose run samples are in the chunk
+		std::size_t begin = first > offset ? (first - offset + stride - 1) / stride : 0;
+		std::size_t end = std::min(_requests[request].count, (first + count - offset + stride - 1) / stride);
+		if(begin >= end)
+		{
+			continue;
+		}
+
+		if(stride == 1)
+		{
+			std::size_t start = offset + begin - first;
+			output(request, begin, end - begin, x + start, y + start, z + start);
+			continue;
+		}
+
+		gathered_x.resize(end - begin);
+		gathered_y.resize(end - begin);
+		gathered_z.resize(end - begin);
+		for(std::size_t index = begin; index < end; index++)
+		{
+			std::size_t sample = offset + index * stride - first;
+			gathered_x[index - begin] = x[sample];
+			gathered_y[index - begin] = y[sample];
+			gathered_z[index - begin] = z[sample];
+		}
+		output(request, begin, end - begin, gathered_x.data(), gathered_y.data(), gathered_z.data());
+	}
+}
@@ -3,15 +3,13 @@
 #include "JulianDate.hpp"
 
 
+#include <cmath>
 #include <iostream>
 
 
 #include "Datetime.hpp"
 #include "Geolocation.hpp"
-
-
-const unsigned int JulianDate::MJDUPPER = 58664;
-const unsigned int JulianDate::MJDLOWER = 41317;
+#include "LeapSecondTable.hpp"
 
 
 JulianDate::JulianDate(unsigned int modified_julian_date, double fractional_modified_julian_date)
@@ -25,6 +23,12 @@ unsigned int JulianDate::modified_julian_date()
 }
 
 
+double JulianDate::fractional_modified_julian_date()
+{
+	return _fractional_modified_julian_date;
+}
+
+
 JulianDate::operator Datetime()
 /*
 solid.f [LN 1182–1189]
@@ -231,6 +235,7 @@ mjd0 — initial_modified_julian_date
 	|***** parameter(MJDUPPER=58299)    !*** upper limit, leap second table, 2018jun30
 	|      parameter(MJDLOWER=41317)    !*** lower limit, leap second table, 1972jan01
 	```
+	The limits are those of `LeapSecondTable::current()`.
 	*/
 
 	/*
@@ -251,188 +256,41 @@ mjd0 — initial_modified_julian_date
 	|        go to 2
 	|      endif
 	```
+	The loops find the UTC day that holds tsec; floor does the same in one step. Only the day is needed (to pick the
+	 table entry): the returned time stays relative to `initial_modified_julian_date`, like `tsec`.
 	*/
-	for(int limit = 365*2100; time_seconds_UTC >= 86400.0 && limit > 0; limit--)
-	{
-		time_seconds_UTC -= 86400.0;
-		initial_modified_julian_date++;
-	}
-
-	for(int limit = 365*2100; time_seconds_UTC < 0.0 && limit > 0; limit--)
-	{
-		time_seconds_UTC += 86400.0;
-		initial_modified_julian_date--;
-	}
+	int day = static_cast<int>(initial_modified_julian_date)
+		+ static_cast<int>(std::floor(time_seconds_UTC / 86400.0));
 
 	/*
-	solid.f [LN 1292–1306]
+	solid.f [LN 1292–1306...1308–1410]
 	```
-	|*** test upper table limit         (upper limit set by bulletin C memos)
-	|
 	|      if(mjd0t.gt.MJDUPPER) then
 	|        leapflag  =.true.               !*** true means flag *IS* raised
 	|        getutcmtai= -37.d0              !*** return the upper table value
 	|        return
 	|      endif
-	|
-	|*** test lower table limit
-	|
+	⋮
 	|      if(mjd0t.lt.MJDLOWER) then
 	|        leapflag=.true.                 !*** true means flag *IS* raised
 	|        getutcmtai= -10.d0              !*** return the lower table value
 	|        return
 	|      endif
-
+	⋮
+	|      getutcmtai = -tai_utc
 	```
+	Outside the table, the nearest value is used (as solid.f does) & `LeapSecondTable::contains()` is false; the flag is
+	 `EpochContext::leap_second_flag`.
 	*/
-	if(initial_modified_julian_date > JulianDate::MJDUPPER)
-	{
-		//TODO: LEAPFLAG
-		return -37.0;
-	}
-
-	if(initial_modified_julian_date < MJDLOWER)
-	{
-		//TODO: LEAPFLAG
-		return -10.0;
-	}
+	double getutcmtai = -LeapSecondTable::current().TAI_minus_UTC(day);
 
 	/*
-	solid.f [LN 1308–1410]
+	solid.f [LN 1251]
 	```
-	|***** http://maia.usno.navy.mil/ser7/tai-utc.dat
-	|*** 1972 JAN  1 =JD 2441317.5  TAI-UTC=  10.0s
-	|*** 1972 JUL  1 =JD 2441499.5  TAI-UTC=  11.0s
-	|*** 1973 JAN  1 =JD 2441683.5  TAI-UTC=  12.0s
-	|*** 1974 JAN  1 =JD 2442048.5  TAI-UTC=  13.0s
-	|*** 1975 JAN  1 =JD 2442413.5  TAI-UTC=  14.0s
-	|*** 1976 JAN  1 =JD 2442778.5  TAI-UTC=  15.0s
-	|*** 1977 JAN  1 =JD 2443144.5  TAI-UTC=  16.0s
-	|*** 1978 JAN  1 =JD 2443509.5  TAI-UTC=  17.0s
-	|*** 1979 JAN  1 =JD 2443874.5  TAI-UTC=  18.0s
-	|*** 1980 JAN  1 =JD 2444239.5  TAI-UTC=  19.0s
-	|*** 1981 JUL  1 =JD 2444786.5  TAI-UTC=  20.0s
-	|*** 1982 JUL  1 =JD 2445151.5  TAI-UTC=  21.0s
-	|*** 1983 JUL  1 =JD 2445516.5  TAI-UTC=  22.0s
-	|*** 1985 JUL  1 =JD 2446247.5  TAI-UTC=  23.0s
-	|*** 1988 JAN  1 =JD 2447161.5  TAI-UTC=  24.0s
-	|*** 1990 JAN  1 =JD 2447892.5  TAI-UTC=  25.0s
-	|*** 1991 JAN  1 =JD 2448257.5  TAI-UTC=  26.0s
-	|*** 1992 JUL  1 =JD 2448804.5  TAI-UTC=  27.0s
-	|*** 1993 JUL  1 =JD 2449169.5  TAI-UTC=  28.0s
-	|*** 1994 JUL  1 =JD 2449534.5  TAI-UTC=  29.0s
-	|*** 1996 JAN  1 =JD 2450083.5  TAI-UTC=  30.0s
-	|*** 1997 JUL  1 =JD 2450630.5  TAI-UTC=  31.0s
-	|*** 1999 JAN  1 =JD 2451179.5  TAI-UTC=  32.0s
-	|*** 2006 JAN  1 =JD 2453736.5  TAI-UTC=  33.0s
-	|*** 2009 JAN  1 =JD 2454832.5  TAI-UTC=  34.0s
-	|*** 2012 JUL  1 =JD 2456109.5  TAI-UTC=  35.0s
-	|*** 2015 JUL  1 =JD 2457204.5  TAI-UTC=  36.0s
-	|*** 2017 JAN  1 =JD 2457754.5  TAI-UTC=  37.0s
-	|***** other leap second references at:
-	|***** http://hpiers.obspm.fr/eoppc/bul/bulc/Leap_Second_History.dat
-	|***** http://hpiers.obspm.fr/eoppc/bul/bulc/bulletinc.dat
-	|
-	|*** test against newest leaps first
-	|
-	|      if    (mjd0t.ge.57754) then       !*** 2017 JAN 1 = 57754
-	|        tai_utc = 37.d0
-	|      elseif(mjd0t.ge.57204) then       !*** 2015 JUL 1 = 57204
-	|        tai_utc = 36.d0
-	|      elseif(mjd0t.ge.56109) then       !*** 2012 JUL 1 = 56109
-	|        tai_utc = 35.d0
-	|      elseif(mjd0t.ge.54832) then       !*** 2009 JAN 1 = 54832
-	|        tai_utc = 34.d0
-	|      elseif(mjd0t.ge.53736) then       !*** 2006 JAN 1 = 53736
-	|        tai_utc = 33.d0
-	|      elseif(mjd0t.ge.51179) then       !*** 1999 JAN 1 = 51179
-	|        tai_utc = 32.d0
-	|      elseif(mjd0t.ge.50630) then       !*** 1997 JUL 1 = 50630
-	|        tai_utc = 31.d0
-	|      elseif(mjd0t.ge.50083) then       !*** 1996 JAN 1 = 50083
-	|        tai_utc = 30.d0
-	|      elseif(mjd0t.ge.49534) then       !*** 1994 JUL 1 = 49534
-	|        tai_utc = 29.d0
-	|      elseif(mjd0t.ge.49169) then       !*** 1993 JUL 1 = 49169
-	|        tai_utc = 28.d0
-	|      elseif(mjd0t.ge.48804) then       !*** 1992 JUL 1 = 48804
-	|        tai_utc = 27.d0
-	|      elseif(mjd0t.ge.48257) then       !*** 1991 JAN 1 = 48257
-	|        tai_utc = 26.d0
-	|      elseif(mjd0t.ge.47892) then       !*** 1990 JAN 1 = 47892
-	|        tai_utc = 25.d0
-	|      elseif(mjd0t.ge.47161) then       !*** 1988 JAN 1 = 47161
-	|        tai_utc = 24.d0
-	|      elseif(mjd0t.ge.46247) then       !*** 1985 JUL 1 = 46247
-	|        tai_utc = 23.d0
-	|      elseif(mjd0t.ge.45516) then       !*** 1983 JUL 1 = 45516
-	|        tai_utc = 22.d0
-	|      elseif(mjd0t.ge.45151) then       !*** 1982 JUL 1 = 45151
-	|        tai_utc = 21.d0
-	|      elseif(mjd0t.ge.44786) then       !*** 1981 JUL 1 = 44786
-	|        tai_utc = 20.d0
-	|      elseif(mjd0t.ge.44239) then       !*** 1980 JAN 1 = 44239
-	|        tai_utc = 19.d0
-	|      elseif(mjd0t.ge.43874) then       !*** 1979 JAN 1 = 43874
-	|        tai_utc = 18.d0
-	|      elseif(mjd0t.ge.43509) then       !*** 1978 JAN 1 = 43509
-	|        tai_utc = 17.d0
-	|      elseif(mjd0t.ge.43144) then       !*** 1977 JAN 1 = 43144
-	|        tai_utc = 16.d0
-	|      elseif(mjd0t.ge.42778) then       !*** 1976 JAN 1 = 42778
-	|        tai_utc = 15.d0
-	|      elseif(mjd0t.ge.42413) then       !*** 1975 JAN 1 = 42413
-	|        tai_utc = 14.d0
-	|      elseif(mjd0t.ge.42048) then       !*** 1974 JAN 1 = 42048
-	|        tai_utc = 13.d0
-	|      elseif(mjd0t.ge.41683) then       !*** 1973 JAN 1 = 41683
-	|        tai_utc = 12.d0
-	|      elseif(mjd0t.ge.41499) then       !*** 1972 JUL 1 = 41499
-	|        tai_utc = 11.d0
-	|      elseif(mjd0t.ge.41317) then       !*** 1972 JAN 1 = 41317
-	|        tai_utc = 10.d0
-	|
-	|*** should never, ever get here
-	|
-	|      else
-	|        write(*,*) 'FATAL ERROR --'
-	|        write(*,*) 'fell thru tests in gpsleap()'
-	|        stop 66768
-	|      endif
-	|
-	|*** return utc - tai (in seconds)
-	|
-	|      getutcmtai = -tai_utc
+	|      utc2tai = tutc - getutcmtai(tutc)
 	```
 	*/
-	int seconds_for_years[] = {
-		57754, 57204, 56109, 54832, 53736, 51179, 50630, 50083, 49534, 49169, 48804, 48257, 47892, 47161, 46247, 45516,
-		45151, 44786, 44239, 43874, 43509, 43144, 42778, 42413, 42048, 41683, 41499, 41317
-	};
-	for(int x = 0; x < sizeof(seconds_for_years) / sizeof(int); x++)
-	{
-		if(initial_modified_julian_date >= seconds_for_years[x])
-		{
-			/*
-			solid.f [LN 1410]
-			```
-			|      getutcmtai = -tai_utc
-			```
-			*/
-			double tai_utc = (37.0 - x);
-			double getutcmtai = -tai_utc;
-
-			/*
-			solid.f [LN 1251]
-			```
-			|      utc2tai = tutc - getutcmtai(tutc)
-			```
-			*/
-			return time_seconds_UTC - getutcmtai;
-		}
-	}
-
-	throw std::runtime_error("FATAL ERROR: Fell through tests in GPS leap");
+	return time_seconds_UTC - getutcmtai;
 }
 
 
@@ -462,9 +320,10 @@ solid.f [LN ]
 	|      d =(mjd-51544) + (fmjdutc-0.5d0)                  !*** days since J2000
 	```
 	*/
-	double time_seconds_UTC = _fractional_modified_julian_date;
+	double time_seconds_UTC = _fractional_modified_julian_date * 86400.0;
 	double fractional_modified_julian_date_UTC = time_seconds_UTC / 86400.0;
-	double days_since_J2000 = (_modified_julian_date - 51544) + (fractional_modified_julian_date_UTC - 0.5);
+	double days_since_J2000 = (static_cast<int>(_modified_julian_date) - 51544)
+		+ (fractional_modified_julian_date_UTC - 0.5);
 
 	/*
 	solid.f [LN ]
@@ -480,7 +339,6 @@ solid.f [LN ]
 	```
 	*/
 	double GreenwichHourAngleDegrees = 280.46061837504 + 360.9856473662862 * days_since_J2000;
-	int i = GreenwichHourAngleDegrees / 360.0;
 
 	/*
 	solid.f [LN ]
@@ -499,7 +357,8 @@ solid.f [LN ]
 	|      end
 	```
 	*/
-	double GreenwichHourAngleRadians = (GreenwichHourAngleDegrees - i * 360.0) / Geolocation::RADIAN;
+	// `i` as `fmod`, which cannot overflow
+	double GreenwichHourAngleRadians = std::fmod(GreenwichHourAngleDegrees, 360.0) / Geolocation::RADIAN;
 	for(int limit = 360; limit >= 0 && GreenwichHourAngleRadians > (Geolocation::PI * 2); limit--)
 	{
 		GreenwichHourAngleRadians -= Geolocation::PI * 2;
@@ -0,0 +1,220 @@
+
+
+#include "LeapSecondTable.hpp"
+
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+
+#include "Datetime.hpp"
+#include "JulianDate.hpp"
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+LeapSecondTable::LeapSecondTable()
+/*
+solid.f [LN 1308–1400]
+```
+|***** http://maia.usno.navy.mil/ser7/tai-utc.dat
+|*** 1972 JAN  1 =JD 2441317.5  TAI-UTC=  10.0s
+⋮
+|*** 2017 JAN  1 =JD 2457754.5  TAI-UTC=  37.0s
+```
+solid.f stops trusting the table after MJD 58664 (2019jun30). No leap second has been introduced since, and IERS
+ Bulletin C 70 extends the 37 s value through 2026jun28 (MJD 61219), the expiry of the matching `Leap_Second.dat`.
+ Later epochs raise the leap second flag until a newer `Leap_Second.dat` is loaded.
+*/
+: _modified_julian_dates{
+	41317, 41499, 41683, 42048, 42413, 42778, 43144, 43509, 43874, 44239, 44786, 45151, 45516, 46247, 47161, 47892,
+	48257, 48804, 49169, 49534, 50083, 50630, 51179, 53736, 54832, 56109, 57204, 57754
+  },
+  _TAI_minus_UTC{
+	10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0, 21.0, 22.0, 23.0, 24.0, 25.0,
+	26.0, 27.0, 28.0, 29.0, 30.0, 31.0, 32.0, 33.0, 34.0, 35.0, 36.0, 37.0
+  },
+  _last_modified_julian_date{61219}
+{}
+
+
+LeapSecondTable::LeapSecondTable(const std::string& path)
+/*
+Reads an IERS `Leap_Second.dat` (https://hpiers.obspm.fr/iers/bul/bulc/Leap_Second.dat):
+```
+|#  File expires on 28 June 2026
+|#
+|#    MJD        Date        TAI-UTC (s)
+|#           day month year
+|#    ---    --------------   ------
+|#
+|    41317.0    1  1 1972       10
+|    41499.0    1  7 1972       11
+```
+Lines starting with `#` are comments, except for the expiry date, which becomes `last_modified_julian_date()`. Without
+ one, the table is taken to be valid through its last entry.
+*/
+: _last_modified_julian_date{0}
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("Unable to open leap second table " + path);
+	}
+
+	const char* month_names[] = {
+		"January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November",
+		"December"
+	};
+
+	std::string line;
+	for(unsigned int line_number = 1; std::getline(file, line); line_number++)
+	{
+		if(!line.empty() && line[0] == '#')
+		{
+			std::size_t expires = line.find("expires on");
+			if(expires != std::string::npos)
+			{
+				std::istringstream date(line.substr(expires + 10));
+				unsigned int day, year;
+				std::string month_name;
+				if(date >> day >> month_name >> year)
+				{
+					for(unsigned int month = 0; month < 12; month++)
+					{
+						if(month_name == month_names[month])
+						{
+							JulianDate expiry = Datetime(year, month + 1, day);
+							_last_modified_julian_date = expiry.modified_julian_date();
+						}
+					}
+				}
+			}
+			continue;
+		}
+
+		std::istringstream fields(line);
+		double modified_julian_date, TAI_minus_UTC;
+		int day, month, year;
+		if(!(fields >> modified_julian_date))
+		{
+			continue;  // Blank line
+		}
+		if(!(fields >> day >> month >> year >> TAI_minus_UTC))
+		{
+			throw std::runtime_error("Malformed leap second entry on line " + std::to_string(line_number) + " of "
+				+ path);
+		}
+		if(!_modified_julian_dates.empty() && modified_julian_date <= _modified_julian_dates.back())
+		{
+			throw std::runtime_error("Leap second entries are not in date order on line " + std::to_string(line_number)
+				+ " of " + path);
+		}
+
+		_modified_julian_dates.push_back(static_cast<int>(modified_julian_date));
+		_TAI_minus_UTC.push_back(TAI_minus_UTC);
+	}
+
+	if(_modified_julian_dates.empty())
+	{
+		throw std::runtime_error("No leap second entries in " + path);
+	}
+	_last_modified_julian_date = std::max(_last_modified_julian_date, _modified_julian_dates.back());
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+const LeapSecondTable& LeapSecondTable::current()
+/*
+The table `JulianDate` converts with. The built-in one until `load()` replaces it.
+*/
+{
+	return *current_table().load(std::memory_order_acquire);
+}
+
+
+void LeapSecondTable::load(const std::string& path)
+/*
+Replaces the current table with the file at `path`. The file is parsed into a new table that is then published with one
+ atomic store, so that `load()` may run while other threads convert: each lookup reads the old table or the new one,
+ never a table being written. A replaced table may still be in use, so it is kept (until exit) rather than freed; a
+ table is a few hundred bytes & loads are rare.
+*/
+{
+	std::unique_ptr<LeapSecondTable> table(new LeapSecondTable(path));
+
+	static std::mutex mutex;
+	static std::vector<std::unique_ptr<LeapSecondTable>> loaded_tables;
+	std::lock_guard<std::mutex> lock(mutex);
+	loaded_tables.push_back(std::move(table));
+	current_table().store(loaded_tables.back().get(), std::memory_order_release);
+}
+
+
+std::atomic<const LeapSecondTable*>& LeapSecondTable::current_table()
+{
+	static const LeapSecondTable built_in_table;
+	static std::atomic<const LeapSecondTable*> table{&built_in_table};
+	return table;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+bool LeapSecondTable::contains(int modified_julian_date) const
+/*
+solid.f [LN 1294–1306]
+```
+|      if(mjd0t.gt.MJDUPPER) then
+|        leapflag  =.true.               !*** true means flag *IS* raised
+⋮
+|      if(mjd0t.lt.MJDLOWER) then
+|        leapflag=.true.                 !*** true means flag *IS* raised
+```
+*/
+{
+	return _modified_julian_dates.front() <= modified_julian_date
+	  && modified_julian_date <= _last_modified_julian_date;
+}
+
+
+double LeapSecondTable::TAI_minus_UTC(int modified_julian_date) const
+/*
+solid.f [LN 1334–1390]
+```
+|      if    (mjd0t.ge.57754) then       !*** 2017 JAN 1 = 57754
+|        tai_utc = 37.d0
+|      elseif(mjd0t.ge.57204) then       !*** 2015 JUL 1 = 57204
+⋮
+|      elseif(mjd0t.ge.41317) then       !*** 1972 JAN 1 = 41317
+|        tai_utc = 10.d0
+```
+The last entry that took effect on or before `modified_julian_date`. Before the first entry, the first value (as solid.f
+ returns for dates below MJDLOWER).
+*/
+{
+	std::vector<int>::const_iterator after = std::upper_bound(_modified_julian_dates.begin(),
+		_modified_julian_dates.end(), modified_julian_date);
+	if(after == _modified_julian_dates.begin())
+	{
+		return _TAI_minus_UTC.front();
+	}
+	return _TAI_minus_UTC[after - _modified_julian_dates.begin() - 1];
+}
+
+
+int LeapSecondTable::first_modified_julian_date() const
+{
+	return _modified_julian_dates.front();
+}
+
+
+int LeapSecondTable::last_modified_julian_date() const
+{
+	return _last_modified_julian_date;
+}
@@ -1,11 +1,16 @@
 
 
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 
+#include "BatchJob.hpp"
 #include "Geolocation.hpp"
 #include "Datetime.hpp"
 #include "JulianDate.hpp"
+#include "SolidTextWriter.hpp"
 
 
 template<class T>
@@ -66,7 +71,7 @@ Datetime date_from_user()
 }
 
 
-Geolocation geolocation_from_user()
+Geolocation geolocation_from_user(double& latitude_degrees, double& longitude_degrees)
 {
 	/*
 	solid.f [LN 42–48]
@@ -80,24 +85,17 @@ Geolocation geolocation_from_user()
 	|      if(glod.lt.-360.d0.or.glod.gt.360.d0) go to 5
 	```
 	*/
-	double latitude_degrees = get_number_from_cin("Latitude [-90, +90] °N: ", -90.0, 90.0);
-	double longitude_degrees = get_number_from_cin("Longitude [-180, +180] °E: ", -180.0, 180.0);
+	latitude_degrees = get_number_from_cin("Latitude [-90, +90] °N: ", -90.0, 90.0);
+	longitude_degrees = get_number_from_cin("Longitude [-360, +360] °E: ", -360.0, 360.0);
 
-	/*
-	Convert longitude to a double in range [0.0, 360.0)
-	solid.f [LN 52–53]
-	```
-	|      if(glod.lt.  0.d0) glod=glod+360.d0
-	|      if(glod.ge.360.d0) glod=glod-360.d0
-	```
-	*/
-	longitude_degrees += (180.0 * (longitude_degrees < 0.0)) + (-180.0 * (longitude_degrees >= 180.0));
+	// Convert longitude to a double in range [0.0, 360.0), solid.f [LN 52–53]
+	longitude_degrees = Geolocation::east_longitude(longitude_degrees);
 
 	return Geolocation(latitude_degrees, longitude_degrees);
 }
 
 
-int main()
+int main(int argument_count, char* arguments[])
 /*
 solid.f [LN 1...612]
 ```
@@ -111,8 +109,29 @@ solid.f [LN 1...612]
 |
 |      write(*,*) 'program solid -- UTC version -- 2018jun01'
 ```
+With arguments, runs a `BatchJob` instead of asking for one station & day.
 */
 {
+	if(argument_count > 1)
+	{
+		if(std::strcmp(arguments[1], "--help") == 0)
+		{
+			std::cout << BatchJob::USAGE;
+			return 0;
+		}
+
+		try
+		{
+			BatchJob(argument_count, arguments).run();
+		}
+		catch(std::exception& error)
+		{
+			std::cerr << error.what() << "\n" << BatchJob::USAGE;
+			return 1;
+		}
+		return 0;
+	}
+
 /*
 solid.f [LN 42...61]
 ```
@@ -121,7 +140,8 @@ solid.f [LN 42...61]
 |      xsta(3)=z0
 ```
 */
-	Geolocation location = geolocation_from_user();
+	double latitude_degrees, longitude_degrees;
+	Geolocation location = geolocation_from_user(latitude_degrees, longitude_degrees);
 
 	/*
 	solid.f [LN 30...40,70...75]
@@ -157,9 +177,38 @@ solid.f [LN 42...61]
 	|      do iloop=0,60*24
 	```
 	*/
-	for(int minute = 0; minute < 1440 /* minutes in a day */; minute++)
-	{
-		Coordinate<double> tide = location.tide(initial_modified_julian_date, julian_date);
-	}
+	const std::size_t samples = 60 * 24 + 1;  // `do iloop=0,60*24` is inclusive of both ends
+	std::vector<double> tide_x(samples), tide_y(samples), tide_z(samples);
+	location.tide_series(initial_modified_julian_date, julian_date.fractional_modified_julian_date(), 60.0, samples,
+		tide_x.data(), tide_y.data(), tide_z.data());
+
+	/*
+	solid.f [LN 87–89]
+	```
+	|*** determine local geodetic horizon components (topocentric)
+	|
+	|        call rge(gla0,glo0,ut,vt,wt,xt,   yt,   zt)       !*** tide vector
+	```
+	*/
+	location.local_horizon(samples, tide_x.data(), tide_y.data(), tide_z.data(), tide_x.data(), tide_y.data(),
+		tide_z.data());
+
+	/*
+	solid.f [LN 25–26...63–66...91–95]
+	```
+	|      open(lout,file='solid.txt',form='formatted',status='unknown')
+	⋮
+	|      write(lout,'(a,i5,2i3)') 'year,month,day= ',iyr,imo,idy
+	|      write(lout,'(a,2f15.9)') 'lat, East lon.= ',glad,glod
+	⋮
+	|        tsec=ihr*3600.d0+imn*60.d0+sec
+	|        write(lout,'(f8.1,3f10.6)') tsec,ut,vt,wt
+	```
+	*/
+	SolidTextWriter solid_text("solid.txt");
+	solid_text.header(normalized_datetime.year(), normalized_datetime.month(), normalized_datetime.day(),
+		latitude_degrees, longitude_degrees);
+	solid_text.series(0.0, 60.0, samples, tide_x.data(), tide_y.data(), tide_z.data());
+	solid_text.flush();
 }
 
@@ -0,0 +1,270 @@
+
+
+#include "SolidEarthTideC.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+
+#include "Coordinate.hpp"
+#include "EphemerisKernels.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+#include "LeapSecondTable.hpp"
+#include "StageTimer.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+
+
+// Years 1901–2099, as solid.f accepts: 1901-01-01 is MJD 15385 & 2100-01-01 is MJD 88069
+static const std::int32_t FIRST_MODIFIED_JULIAN_DATE = 15385;
+static const std::int32_t END_MODIFIED_JULIAN_DATE = 88069;
+static const std::size_t EPOCH_BLOCK = 256;  // Epochs per `EphemerisKernels` call & thread pool task
+// Stations per thread pool task, so that a call with many stations & few epochs (a network at one epoch) still spreads
+//  over the threads; each task's epochs cost about `EPOCH_BLOCK` kernel evaluations, under 1% of its stations' tides
+static const std::size_t STATION_BLOCK = 1024;
+
+
+static void evaluate_block(std::vector<Geolocation>& geolocations, const std::vector<StationFrame>& station_frames,
+	const std::int32_t* modified_julian_dates, const double* fractional_modified_julian_dates, std::size_t epoch_count,
+	std::size_t first_epoch, std::size_t last_epoch, std::size_t first_station, std::size_t last_station, int frame,
+	double* x, double* y, double* z, std::uint8_t* leap_second_flags
+)
+/*
+The contexts of epochs [`first_epoch`, `last_epoch`) are built directly, their sun & moon come from one
+ `EphemerisKernels` call, and stations [`first_station`, `last_station`) reuse them. The epochs' leap second flags are
+ written by the block of the first stations only.
+*/
+{
+	std::vector<EpochContext> epoch_contexts;
+	epoch_contexts.reserve(last_epoch - first_epoch);
+	double terrestrial_time[EPOCH_BLOCK];
+	double solar_x[EPOCH_BLOCK], solar_y[EPOCH_BLOCK], solar_z[EPOCH_BLOCK];
+	double lunar_x[EPOCH_BLOCK], lunar_y[EPOCH_BLOCK], lunar_z[EPOCH_BLOCK];
+
+	SOLID_EARTH_TIDE_STAGE_COUNT(stage_timer, TIME_SCALES, last_epoch - first_epoch);
+	for(std::size_t epoch = first_epoch; epoch < last_epoch; epoch++)
+	{
+		JulianDate julian_date(modified_julian_dates[epoch], fractional_modified_julian_dates[epoch]);
+		epoch_contexts.push_back(EpochContext(modified_julian_dates[epoch], julian_date));
+		terrestrial_time[epoch - first_epoch] = epoch_contexts.back().julian_centuries;
+		if(leap_second_flags && first_station == 0)
+		{
+			leap_second_flags[epoch] = epoch_contexts.back().leap_second_flag;
+		}
+	}
+
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, SUN);
+	EphemerisKernels::sun_inertial_coordinates(terrestrial_time, epoch_contexts.size(), solar_x, solar_y, solar_z);
+	SOLID_EARTH_TIDE_STAGE_NEXT(stage_timer, MOON);
+	EphemerisKernels::moon_inertial_coordinates(terrestrial_time, epoch_contexts.size(), lunar_x, lunar_y, lunar_z);
+	SOLID_EARTH_TIDE_STAGE_STOP(stage_timer);
+
+	for(std::size_t epoch = first_epoch; epoch < last_epoch; epoch++)
+	{
+		std::size_t index = epoch - first_epoch;
+		const EpochContext& epoch_context = epoch_contexts[index];
+		Coordinate<double> solar_coordinate = Coordinate<double>(solar_x[index], solar_y[index], solar_z[index])
+			.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+		Coordinate<double> lunar_coordinate = Coordinate<double>(lunar_x[index], lunar_y[index], lunar_z[index])
+			.rotate3(epoch_context.sin_greenwich_hour_angle, epoch_context.cos_greenwich_hour_angle);
+
+		for(std::size_t station = first_station; station < last_station; station++)
+		{
+			Geolocation& geolocation = geolocations[station];
+			Coordinate<double> displacement = geolocation.tide(epoch_context, station_frames[station], solar_coordinate,
+				lunar_coordinate);
+			double displacement_x = displacement[X], displacement_y = displacement[Y], displacement_z = displacement[Z];
+			std::size_t output = station * epoch_count + epoch;
+			if(frame == SOLID_EARTH_TIDE_ENU)
+			{
+				double north, east, up;
+				geolocation.local_horizon(1, &displacement_x, &displacement_y, &displacement_z, &north, &east, &up);
+				x[output] = east;
+				y[output] = north;
+				z[output] = up;
+			}
+			else
+			{
+				x[output] = displacement_x;
+				y[output] = displacement_y;
+				z[output] = displacement_z;
+			}
+		}
+	}
+}
+
+
+static std::mutex& thread_pool_mutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+
+static ThreadPool& thread_pool(unsigned int threads)
+/*
+One pool for every call, so that callers evaluating a few epochs at a time do not start threads each time; it is
+ replaced when a call asks for a different number of threads. Must be called with `thread_pool_mutex()` held, which
+ `solid_earth_tide_evaluate` only tries to take: a call made while another uses the pool runs on its own thread.
+*/
+{
+	static std::unique_ptr<ThreadPool> pool;
+	static unsigned int pool_threads = 0;
+	if(!pool || pool_threads != threads)
+	{
+		pool.reset();
+		pool.reset(new ThreadPool(threads));
+		pool_threads = threads;
+	}
+	return *pool;
+}
+
+
+extern "C"
+{
+
+
+int solid_earth_tide_abi_version(void)
+{
+	return SOLID_EARTH_TIDE_ABI_VERSION;
+}
+
+
+const char* solid_earth_tide_status_message(int status)
+{
+	switch(status)
+	{
+		case SOLID_EARTH_TIDE_OK:
+			return "OK";
+		case SOLID_EARTH_TIDE_INVALID_ARGUMENT:
+			return "Invalid argument: a null buffer, or a station, epoch or frame out of range";
+		case SOLID_EARTH_TIDE_FILE_ERROR:
+			return "Unable to read the leap second file";
+		case SOLID_EARTH_TIDE_INTERNAL_ERROR:
+			return "Internal error";
+		default:
+			return "Unknown status";
+	}
+}
+
+
+int solid_earth_tide_load_leap_seconds(const char* path)
+{
+	if(!path)
+	{
+		return SOLID_EARTH_TIDE_INVALID_ARGUMENT;
+	}
+
+	try
+	{
+		LeapSecondTable::load(path);
+	}
+	catch(std::runtime_error&)
+	{
+		return SOLID_EARTH_TIDE_FILE_ERROR;
+	}
+	catch(std::exception&)
+	{
+		return SOLID_EARTH_TIDE_INTERNAL_ERROR;
+	}
+	return SOLID_EARTH_TIDE_OK;
+}
+
+
+int solid_earth_tide_evaluate(const double* latitudes_degrees, const double* longitudes_degrees,
+	const double* heights_meters, size_t station_count, const int32_t* modified_julian_dates,
+	const double* fractional_modified_julian_dates, size_t epoch_count, int frame, unsigned int threads, double* x,
+	double* y, double* z, uint8_t* leap_second_flags
+)
+/*
+Exceptions must not cross the C boundary, so all of them become `SOLID_EARTH_TIDE_INTERNAL_ERROR`.
+*/
+{
+	if((station_count && (!latitudes_degrees || !longitudes_degrees))
+	  || (epoch_count && (!modified_julian_dates || !fractional_modified_julian_dates))
+	  || (station_count && epoch_count && (!x || !y || !z))
+	  || (frame != SOLID_EARTH_TIDE_ECEF && frame != SOLID_EARTH_TIDE_ENU)
+	)
+	{
+		return SOLID_EARTH_TIDE_INVALID_ARGUMENT;
+	}
+	for(std::size_t station = 0; station < station_count; station++)
+	{
+		if(!(-90.0 <= latitudes_degrees[station] && latitudes_degrees[station] <= 90.0)
+		  || !(-360.0 <= longitudes_degrees[station] && longitudes_degrees[station] <= 360.0)
+		  || (heights_meters && !std::isfinite(heights_meters[station]))
+		)
+		{
+			return SOLID_EARTH_TIDE_INVALID_ARGUMENT;
+		}
+	}
+	for(std::size_t epoch = 0; epoch < epoch_count; epoch++)
+	{
+		if(modified_julian_dates[epoch] < FIRST_MODIFIED_JULIAN_DATE
+		  || modified_julian_dates[epoch] >= END_MODIFIED_JULIAN_DATE
+		  || !(0.0 <= fractional_modified_julian_dates[epoch] && fractional_modified_julian_dates[epoch] < 1.0)
+		)
+		{
+			return SOLID_EARTH_TIDE_INVALID_ARGUMENT;
+		}
+	}
+
+	try
+	{
+		std::vector<Geolocation> geolocations;
+		std::vector<StationFrame> station_frames;
+		geolocations.reserve(station_count);
+		station_frames.reserve(station_count);
+		for(std::size_t station = 0; station < station_count; station++)
+		{
+			geolocations.push_back(Geolocation(latitudes_degrees[station], longitudes_degrees[station],
+				heights_meters ? heights_meters[station] : 0.0));
+			station_frames.push_back(StationFrame(geolocations.back()));
+		}
+
+		// Tasks are blocks of epochs by blocks of stations, the stations' blocks of an epoch block adjacent
+		std::size_t epoch_blocks = (epoch_count + EPOCH_BLOCK - 1) / EPOCH_BLOCK;
+		std::size_t station_blocks = (station_count + STATION_BLOCK - 1) / STATION_BLOCK;
+		std::size_t blocks = epoch_blocks * station_blocks;
+		std::function<void(std::size_t)> block_task = [&](std::size_t block)
+		{
+			std::size_t first_epoch = block / station_blocks * EPOCH_BLOCK;
+			std::size_t first_station = block % station_blocks * STATION_BLOCK;
+			evaluate_block(geolocations, station_frames, modified_julian_dates, fractional_modified_julian_dates,
+				epoch_count, first_epoch, std::min(first_epoch + EPOCH_BLOCK, epoch_count), first_station,
+				std::min(first_station + STATION_BLOCK, station_count), frame, x, y, z, leap_second_flags);
+		};
+
+		// Concurrent callers (e.g. a host engine's own threads) do not queue for the pool: whoever finds it in use
+		//  evaluates on its calling thread
+		std::unique_lock<std::mutex> lock(thread_pool_mutex(), std::defer_lock);
+		if(blocks > 1 && threads != 1 && lock.try_lock())
+		{
+			thread_pool(threads).run(blocks, block_task);
+		}
+		else
+		{
+			for(std::size_t block = 0; block < blocks; block++)
+			{
+				block_task(block);
+			}
+		}
+	}
+	catch(std::exception&)
+	{
+		return SOLID_EARTH_TIDE_INTERNAL_ERROR;
+	}
+	return SOLID_EARTH_TIDE_OK;
+}
+
+
+}  // extern "C"
@@ -0,0 +1,381 @@
+
+
+#include "SolidTextWriter.hpp"
+
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+#include "Datetime.hpp"
+#include "JulianDate.hpp"
+
+
+const std::size_t SolidTextWriter::BUFFER_BYTES = 1 << 20;
+
+
+// Powers of ten that are exact in a double, for the scaling in `fixed()`
+static const double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+	1e15};
+static const unsigned long long INTEGER_POWERS_OF_TEN[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+	1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+	10000000000000ULL, 100000000000000ULL, 1000000000000000ULL};
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+SolidTextWriter::SolidTextWriter(const std::string& path)
+/*
+solid.f [LN 25–26]
+```
+|      lout=1
+|      open(lout,file='solid.txt',form='formatted',status='unknown')
+```
+*/
+: _file_descriptor{open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)}, _owned{true}, _buffer(BUFFER_BYTES),
+  _used{0}, _has_day{false}, _day{0}
+{
+	if(_file_descriptor < 0)
+	{
+		throw std::runtime_error("Unable to create " + path);
+	}
+}
+
+
+SolidTextWriter::SolidTextWriter(int file_descriptor)
+: _file_descriptor{file_descriptor}, _owned{false}, _buffer(BUFFER_BYTES), _used{0}, _has_day{false}, _day{0}
+{}
+
+
+SolidTextWriter::~SolidTextWriter()
+/*
+Writes out what is left in the buffer. Errors cannot be reported from here; call `flush()` first to see them.
+*/
+{
+	try
+	{
+		flush();
+	}
+	catch(...)
+	{}
+
+	if(_owned)
+	{
+		close(_file_descriptor);
+	}
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void SolidTextWriter::header(int year, int month, int day, double latitude_degrees, double longitude_degrees)
+/*
+solid.f [LN 63–66]
+```
+|*** header
+|
+|      write(lout,'(a,i5,2i3)') 'year,month,day= ',iyr,imo,idy
+|      write(lout,'(a,2f15.9)') 'lat, East lon.= ',glad,glod
+```
+*/
+{
+	text("year,month,day= ", 16);
+	integer(year, 5);
+	integer(month, 3);
+	integer(day, 3);
+	text("\n", 1);
+
+	text("lat, East lon.= ", 16);
+	fixed(latitude_degrees, 15, 9);
+	fixed(longitude_degrees, 15, 9);
+	text("\n", 1);
+}
+
+
+void SolidTextWriter::line(double time_seconds, double north, double east, double up)
+/*
+solid.f [LN 98]
+```
+|        write(lout,'(f8.1,3f10.6)') tsec,ut,vt,wt
+```
+*/
+{
+	fixed(time_seconds, 8, 1);
+	fixed(north, 10, 6);
+	fixed(east, 10, 6);
+	fixed(up, 10, 6);
+	text("\n", 1);
+}
+
+
+void SolidTextWriter::series(double start_seconds, double step_seconds, std::size_t count, const double* north,
+	const double* east, const double* up
+)
+/*
+solid.f [LN 94–100]
+```
+|        call mjdciv(mjd,fmjd               +0.001d0/86400.d0,
+|     *              iyr,imo,idy,ihr,imn,sec-0.001d0)
+|
+|        tsec=ihr*3600.d0+imn*60.d0+sec
+|        write(lout,'(f8.1,3f10.6)') tsec,ut,vt,wt
+|        fmjd=fmjd+tdel2
+|        fmjd=(idnint(fmjd*86400.d0))/86400.d0      !*** force 1 sec. granularity
+```
+One line per sample, sample `index` at `start_seconds` + `index` × `step_seconds` from the start of the first day. The
+ Fortran converts every epoch back to a civil time to get `tsec`; it counts on from the start of the day (the sample
+ after 23:59 is 86400.0), so here it is kept as a count of tenths of a second, advanced per line. Steps that are not
+ a whole number of tenths fall back to formatting the time itself.
+*/
+{
+	double start_tenths = start_seconds * 10.0;
+	double step_tenths = step_seconds * 10.0;
+	bool whole_tenths = start_tenths == std::floor(start_tenths) && step_tenths == std::floor(step_tenths)
+		&& std::fabs(start_tenths + count * step_tenths) < 1e15;
+
+	long long time_tenths = whole_tenths ? static_cast<long long>(start_tenths) : 0;
+	long long time_step_tenths = whole_tenths ? static_cast<long long>(step_tenths) : 0;
+	for(std::size_t index = 0; index < count; index++)
+	{
+		if(whole_tenths)
+		{
+			tenths(time_tenths);
+			time_tenths += time_step_tenths;
+		}
+		else
+		{
+			fixed(start_seconds + index * step_seconds, 8, 1);
+		}
+		fixed(north[index], 10, 6);
+		fixed(east[index], 10, 6);
+		fixed(up[index], 10, 6);
+		text("\n", 1);
+	}
+}
+
+
+void SolidTextWriter::daily_series(unsigned int modified_julian_date, double start_seconds, double step_seconds,
+	std::size_t count, const double* north, const double* east, const double* up, double latitude_degrees,
+	double longitude_degrees
+)
+/*
+solid.f [LN 63–66...94–98] for a series of any length, as solid.f writes its one day: sample `index` at
+ `start_seconds` + `index` × `step_seconds` from the start of `modified_julian_date`. Each UTC day's samples follow a
+ `header()` of that day & count their seconds from its start, so `tsec` stays within f8.1; a sample at midnight ends
+ the day before it (86400.0), as the last of solid.f's day does, when that day has samples. Successive calls continue
+ the series, e.g. one per chunk of it.
+*/
+{
+	std::size_t index = 0;
+	while(index < count)
+	{
+		double seconds = start_seconds + index * step_seconds;
+		double day_start_seconds = _has_day ? (static_cast<double>(_day) - modified_julian_date) * 86400.0 : 0.0;
+		if(!_has_day || seconds - day_start_seconds > 86400.0)
+		{
+			double days = std::floor(seconds / 86400.0);
+			_day = modified_julian_date + static_cast<int>(days);
+			_has_day = true;
+			day_start_seconds = days * 86400.0;
+
+			Datetime date = (Datetime)JulianDate(_day, 0.0);
+			header(date.year(), date.month(), date.day(), latitude_degrees, longitude_degrees);
+		}
+
+		// The samples up to & including the day's closing midnight
+		double last = std::floor((day_start_seconds + 86400.0 - start_seconds) / step_seconds + 1e-9);
+		std::size_t end = last < static_cast<double>(count) ? static_cast<std::size_t>(last) + 1 : count;
+		if(end <= index)
+		{
+			end = index + 1;
+		}
+		series(seconds - day_start_seconds, step_seconds, end - index, north + index, east + index, up + index);
+		index = end;
+	}
+}
+
+
+void SolidTextWriter::flush()
+{
+	std::size_t written = 0;
+	while(written < _used)
+	{
+		ssize_t result = write(_file_descriptor, _buffer.data() + written, _used - written);
+		if(result < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			_used = 0;
+			throw std::runtime_error(std::string("Unable to write tide text: ") + std::strerror(errno));
+		}
+		written += result;
+	}
+	_used = 0;
+}
+
+
+void SolidTextWriter::text(const char* characters, std::size_t length)
+{
+	if(_buffer.size() - _used < length)
+	{
+		flush();
+	}
+	std::memcpy(_buffer.data() + _used, characters, length);
+	_used += length;
+}
+
+
+void SolidTextWriter::tenths(long long value)
+{
+	bool negative = value < 0;
+	unsigned long long magnitude = negative ? -static_cast<unsigned long long>(value) : value;
+	field(negative, magnitude / 10, magnitude % 10, 8, 1);
+}
+
+
+void SolidTextWriter::fixed(double value, unsigned int width, unsigned int decimals)
+/*
+Fortran `f<width>.<decimals>` as gfortran writes it. `value` · 10^`decimals` is rounded on its exact value: the product
+ & its rounding error (from `fma`) decide the ties & near-ties that the rounded product alone would get wrong.
+*/
+{
+	bool negative = std::signbit(value);
+	if(std::isnan(value) || std::isinf(value))
+	{
+		const char* name = std::isnan(value) ? "NaN" : !negative && width >= 8 ? "Infinity"
+			: negative && width >= 9 ? "-Infinity" : negative ? "-Inf" : "Inf";
+		std::size_t length = std::strlen(name);
+		if(width < length)
+		{
+			asterisks(width);
+			return;
+		}
+		for(std::size_t pad = length; pad < width; pad++)
+		{
+			text(" ", 1);
+		}
+		text(name, length);
+		return;
+	}
+
+	double magnitude = std::fabs(value);
+	double product = magnitude * POWERS_OF_TEN[decimals];
+	if(product >= 1e15)
+	{
+		asterisks(width);  // At least 16 digits, wider than any field written here
+		return;
+	}
+
+	double error = std::fma(magnitude, POWERS_OF_TEN[decimals], -product);
+	double rounded = std::nearbyint(product);  // To nearest, ties to even
+	double remainder = product - rounded;  // Exact
+	if(remainder == 0.5 && (error > 0.0 || (error == 0.0 && std::fmod(rounded, 2.0) != 0.0)))
+	{
+		rounded += 1.0;
+	}
+	else if(remainder == -0.5 && (error < 0.0 || (error == 0.0 && std::fmod(rounded, 2.0) != 0.0)))
+	{
+		rounded -= 1.0;
+	}
+
+	unsigned long long scaled = static_cast<unsigned long long>(rounded);
+	field(negative, scaled / INTEGER_POWERS_OF_TEN[decimals], scaled % INTEGER_POWERS_OF_TEN[decimals], width,
+		decimals);
+}
+
+
+void SolidTextWriter::integer(long long value, unsigned int width)
+/*
+Fortran `i<width>`.
+*/
+{
+	bool negative = value < 0;
+	unsigned long long magnitude = negative ? -static_cast<unsigned long long>(value) : value;
+
+	char digits[24];
+	std::size_t length = 0;
+	do
+	{
+		digits[sizeof(digits) - ++length] = '0' + magnitude % 10;
+		magnitude /= 10;
+	}
+	while(magnitude != 0);
+	if(negative)
+	{
+		digits[sizeof(digits) - ++length] = '-';
+	}
+
+	if(length > width)
+	{
+		asterisks(width);
+		return;
+	}
+	for(std::size_t pad = length; pad < width; pad++)
+	{
+		text(" ", 1);
+	}
+	text(digits + sizeof(digits) - length, length);
+}
+
+
+void SolidTextWriter::field(bool negative, unsigned long long whole, unsigned long long fraction, unsigned int width,
+	unsigned int decimals
+)
+/*
+[-]`whole`.`fraction`, right justified in `width`. The zero before the point is left out when it would not fit, and
+ the field is filled with `*` when the number still does not fit.
+*/
+{
+	char characters[48];
+	std::size_t length = 0;
+	for(unsigned int digit = 0; digit < decimals; digit++)
+	{
+		characters[sizeof(characters) - ++length] = '0' + fraction % 10;
+		fraction /= 10;
+	}
+	characters[sizeof(characters) - ++length] = '.';
+
+	std::size_t without_zero = length + negative;
+	do
+	{
+		characters[sizeof(characters) - ++length] = '0' + whole % 10;
+		whole /= 10;
+	}
+	while(whole != 0);
+	if(length + negative > width && characters[sizeof(characters) - length] == '0' && without_zero <= width)
+	{
+		length--;
+	}
+	if(negative)
+	{
+		characters[sizeof(characters) - ++length] = '-';
+	}
+
+	if(length > width)
+	{
+		asterisks(width);
+		return;
+	}
+	for(std::size_t pad = length; pad < width; pad++)
+	{
+		text(" ", 1);
+	}
+	text(characters + sizeof(characters) - length, length);
+}
+
+
+void SolidTextWriter::asterisks(unsigned int width)
+{
+	for(unsigned int index = 0; index < width; index++)
+	{
+		text("*", 1);
+	}
+}
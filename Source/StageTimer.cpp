@@ -0,0 +1,154 @@
+
+
+#include "StageTimer.hpp"
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+
+const std::size_t StageTimer::STAGES;
+const char* const StageTimer::NAMES[STAGES] = {
+	"tide", "time_scales", "sun", "moon", "degree_2_3", "step1/diurnal (st1idiu)", "step1/semi_diurnal (st1isem)",
+	"step1/latitude_dependence (st1l1)", "step2/diurnal (step2diu)", "step2/long_period (step2lon)"
+};
+#if defined(__x86_64__) || defined(__i386__)
+	const char* const StageTimer::UNIT = "cycles";
+#else
+	const char* const StageTimer::UNIT = "ns";
+#endif
+const unsigned int StageTimer::SAMPLING_INTERVAL = 16;
+
+
+static unsigned int environment_sampling_interval()
+{
+	const char* value = std::getenv("SOLID_EARTH_TIDE_SAMPLING");
+	unsigned long interval = value ? std::strtoul(value, nullptr, 10) : 0;
+	return interval ? static_cast<unsigned int>(interval) : StageTimer::SAMPLING_INTERVAL;
+}
+
+
+std::atomic<unsigned int> StageTimer::_sampling_interval{environment_sampling_interval()};
+std::atomic<unsigned long long> StageTimer::_total_calls[STAGES] = {};
+std::atomic<unsigned long long> StageTimer::_total_cycles[STAGES] = {};
+
+
+#ifdef SOLID_EARTH_TIDE_INSTRUMENT
+	static struct ExitReport
+	{
+		~ExitReport()
+		{
+			if(StageTimer::calls(StageTimer::Stage::EVALUATION))
+			{
+				std::cerr << StageTimer::report();
+			}
+		}
+	} exit_report;
+#endif
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+unsigned int StageTimer::sampling_interval()
+{
+	return _sampling_interval.load(std::memory_order_relaxed);
+}
+
+
+void StageTimer::sampling_interval(unsigned int interval)
+/*
+Takes effect on each thread after its current countdown of every stage.
+*/
+{
+	_sampling_interval.store(interval ? interval : 1, std::memory_order_relaxed);
+}
+
+
+unsigned long long StageTimer::calls(Stage stage)
+/*
+The estimated calls of `stage` so far.
+*/
+{
+	return _total_calls[static_cast<std::size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+
+void StageTimer::reset()
+{
+	for(std::size_t stage = 0; stage < STAGES; stage++)
+	{
+		_total_calls[stage].store(0, std::memory_order_relaxed);
+		_total_cycles[stage].store(0, std::memory_order_relaxed);
+	}
+}
+
+
+std::string StageTimer::report()
+/*
+Each stage's estimated calls & cycles per call, & its cycles per `tide()` evaluation (time scales & ephemerides that
+ are shared by the stations of an epoch are spread over them) with its share of the whole.
+*/
+{
+#ifndef SOLID_EARTH_TIDE_INSTRUMENT
+	return "stage timers: not built in (make INSTRUMENT=1)\n";
+#endif
+
+	const std::size_t EVALUATION = static_cast<std::size_t>(Stage::EVALUATION);
+	double calls[STAGES], cycles[STAGES];
+	for(std::size_t stage = 0; stage < STAGES; stage++)
+	{
+		calls[stage] = static_cast<double>(_total_calls[stage].load(std::memory_order_relaxed));
+		cycles[stage] = static_cast<double>(_total_cycles[stage].load(std::memory_order_relaxed));
+	}
+	double evaluations = calls[EVALUATION];
+	if(!evaluations)
+	{
+		return "stage timers: no tide evaluations sampled\n";
+	}
+
+	// The evaluation encloses the stages after MOON; what is left of it is the part of `tide()` outside them
+	double outside = cycles[EVALUATION];
+	for(std::size_t stage = static_cast<std::size_t>(Stage::DEGREE_2_3); stage < STAGES; stage++)
+	{
+		outside -= cycles[stage];
+	}
+	double total = cycles[EVALUATION] + cycles[static_cast<std::size_t>(Stage::TIME_SCALES)]
+		+ cycles[static_cast<std::size_t>(Stage::SUN)] + cycles[static_cast<std::size_t>(Stage::MOON)];
+
+	std::string text;
+	char line[256];
+
+	std::snprintf(line, sizeof(line), "stage timers: %.0f tide evaluations (estimated from 1 in %u calls), %s\n",
+		evaluations, sampling_interval(), UNIT);
+	text += line;
+	std::snprintf(line, sizeof(line), "%-36s %14s %12s %16s %7s\n", "stage", "calls", "per call", "per evaluation",
+		"share");
+	text += line;
+	const Stage order[] = {Stage::TIME_SCALES, Stage::SUN, Stage::MOON, Stage::EVALUATION, Stage::DEGREE_2_3,
+		Stage::STEP1_DIURNAL, Stage::STEP1_SEMI_DIURNAL, Stage::STEP1_LATITUDE_DEPENDENCE, Stage::STEP2_DIURNAL,
+		Stage::STEP2_LONG_PERIOD};
+	for(Stage entry : order)
+	{
+		std::size_t stage = static_cast<std::size_t>(entry);
+		std::snprintf(line, sizeof(line), "%-36s %14.0f %12.1f %16.1f %6.1f%%\n",
+			(std::string(stage > static_cast<std::size_t>(Stage::MOON) ? "  " : "") + NAMES[stage]).c_str(),
+			calls[stage], calls[stage] ? cycles[stage] / calls[stage] : 0.0, cycles[stage] / evaluations,
+			100.0 * cycles[stage] / total);
+		text += line;
+	}
+	std::snprintf(line, sizeof(line), "%-36s %14s %12s %16.1f %6.1f%%\n", "  other (sums, timer reads)", "", "",
+		outside / evaluations, 100.0 * outside / total);
+	text += line;
+	std::snprintf(line, sizeof(line), "%-36s %14s %12s %16.1f %6.1f%%\n", "total", "", "", total / evaluations, 100.0);
+	text += line;
+	return text;
+}
+
+
+void StageTimer::add(Stage stage, unsigned long long calls, unsigned long long cycles)
+{
+	std::size_t index = static_cast<std::size_t>(stage);
+	_total_calls[index].fetch_add(calls, std::memory_order_relaxed);
+	_total_cycles[index].fetch_add(cycles, std::memory_order_relaxed);
+}
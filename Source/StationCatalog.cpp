@@ -0,0 +1,482 @@
+
+
+#include "StationCatalog.hpp"
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#include "Geolocation.hpp"
+
+
+const char StationCatalog::MAGIC[8] = {'S', 'E', 'S', 'T', 'A', 'T', '\0', '\1'};
+const std::uint32_t StationCatalog::VERSION = 1;
+const std::uint32_t StationCatalog::BYTE_ORDER_MARK = 0x01020304;
+const std::size_t StationCatalog::ALIGNMENT;
+
+static_assert(sizeof(StationCatalog::Header) == 64, "StationCatalog::Header must be 64 bytes");
+
+
+// Powers of ten that are exact in a double, for the fast path of `number()`
+static const double EXACT_POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+	1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+StationCatalog::StationCatalog(const std::string& path)
+: _map{MAP_FAILED}, _map_bytes{0}, _size{0}, _latitudes{nullptr}, _longitudes{nullptr}, _heights{nullptr}
+{
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if(descriptor < 0)
+	{
+		throw std::runtime_error("Unable to open station catalog " + path);
+	}
+
+	struct stat status;
+	if(fstat(descriptor, &status) != 0)
+	{
+		close(descriptor);
+		throw std::runtime_error("Unable to read station catalog " + path);
+	}
+
+	_map_bytes = status.st_size;
+	if(_map_bytes != 0)
+	{
+		_map = mmap(nullptr, _map_bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	}
+	close(descriptor);
+	if(_map_bytes != 0 && _map == MAP_FAILED)
+	{
+		throw std::runtime_error("Unable to map station catalog " + path);
+	}
+
+	try
+	{
+		if(_map_bytes >= sizeof(MAGIC) && std::memcmp(_map, MAGIC, sizeof(MAGIC)) == 0)
+		{
+			map_binary(path);
+		}
+		else
+		{
+			parse_csv(path);
+		}
+	}
+	catch(...)
+	{
+		if(_map != MAP_FAILED)
+		{
+			munmap(_map, _map_bytes);
+		}
+		throw;
+	}
+}
+
+
+StationCatalog::~StationCatalog()
+{
+	if(_map != MAP_FAILED)
+	{
+		munmap(_map, _map_bytes);
+	}
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+void StationCatalog::write(const std::string& path, std::size_t count, const double* latitudes_degrees,
+	const double* longitudes_degrees, const double* heights_meters
+)
+/*
+Writes a binary catalog of `count` stations. Each array is padded to the next 64 byte boundary.
+*/
+{
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byte_order = BYTE_ORDER_MARK;
+	header.header_bytes = sizeof(Header);
+	header.count = count;
+
+	std::uint64_t array_bytes = count * sizeof(double);
+	std::uint64_t padded_bytes = (array_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	for(unsigned int index = 0; index < 3; index++)
+	{
+		header.component_offset[index] = sizeof(Header) + index * padded_bytes;
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if(!file)
+	{
+		throw std::runtime_error("Unable to create station catalog " + path);
+	}
+
+	const char padding[ALIGNMENT] = {};
+	const double* components[3] = {latitudes_degrees, longitudes_degrees, heights_meters};
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for(unsigned int index = 0; index < 3; index++)
+	{
+		file.write(reinterpret_cast<const char*>(components[index]), array_bytes);
+		file.write(padding, padded_bytes - array_bytes);
+	}
+
+	if(!file.flush())
+	{
+		throw std::runtime_error("Unable to write station catalog " + path);
+	}
+}
+
+
+const char* StationCatalog::number(const char* begin, const char* end, double& value)
+/*
+Parses a decimal number (`[+-]digits[.digits][(e|E)[+-]digits]`) starting at `begin`, without reading past `end`.
+ Returns the character after it, or null when there is no number at `begin`.
+Numbers of at most 15 significant digits & a power of ten up to 22 (every coordinate in practice) are converted
+ exactly with one multiplication or division of two exact doubles; anything else goes to `strtod`. Either way the
+ result is the correctly rounded double, as `strtod` would give.
+*/
+{
+	const char* position = begin;
+	bool negative = position < end && *position == '-';
+	if(position < end && (*position == '-' || *position == '+'))
+	{
+		position++;
+	}
+
+	std::uint64_t mantissa = 0;
+	int significant_digits = 0;
+	int exponent = 0;
+	bool digits = false;
+	bool truncated = false;
+	for(; position < end && '0' <= *position && *position <= '9'; position++, digits = true)
+	{
+		if(significant_digits < 19)
+		{
+			mantissa = mantissa * 10 + (*position - '0');
+			significant_digits += mantissa != 0;
+		}
+		else
+		{
+			exponent++;
+			truncated |= *position != '0';
+		}
+	}
+	if(position < end && *position == '.')
+	{
+		for(position++; position < end && '0' <= *position && *position <= '9'; position++, digits = true)
+		{
+			if(significant_digits < 19)
+			{
+				mantissa = mantissa * 10 + (*position - '0');
+				significant_digits += mantissa != 0;
+				exponent--;
+			}
+			else
+			{
+				truncated |= *position != '0';
+			}
+		}
+	}
+	if(!digits)
+	{
+		return nullptr;
+	}
+
+	if(position < end && (*position == 'e' || *position == 'E'))
+	{
+		const char* exponent_position = position + 1;
+		bool exponent_negative = exponent_position < end && *exponent_position == '-';
+		if(exponent_position < end && (*exponent_position == '-' || *exponent_position == '+'))
+		{
+			exponent_position++;
+		}
+		if(exponent_position < end && '0' <= *exponent_position && *exponent_position <= '9')
+		{
+			int written_exponent = 0;
+			for(; exponent_position < end && '0' <= *exponent_position && *exponent_position <= '9';
+				exponent_position++
+			)
+			{
+				written_exponent = std::min(written_exponent * 10 + (*exponent_position - '0'), 100000);
+			}
+			exponent += exponent_negative ? -written_exponent : written_exponent;
+			position = exponent_position;
+		}
+	}
+
+	if(!truncated && significant_digits <= 15 && -22 <= exponent && exponent <= 22)
+	{
+		double magnitude = static_cast<double>(mantissa);
+		magnitude = exponent < 0 ? magnitude / EXACT_POWERS_OF_TEN[-exponent]
+			: magnitude * EXACT_POWERS_OF_TEN[exponent];
+		value = negative ? -magnitude : magnitude;
+		return position;
+	}
+
+	char text[128];
+	std::size_t length = position - begin;
+	if(length >= sizeof(text))
+	{
+		return nullptr;
+	}
+	std::memcpy(text, begin, length);
+	text[length] = '\0';
+	value = std::strtod(text, nullptr);
+	return position;
+}
+
+
+const char* StationCatalog::invalid(double latitude_degrees, double longitude_degrees, double height_meters)
+/*
+Why a station cannot be used (in solid.f's ranges, as `BatchJob` accepts them), or `nullptr` if it can.
+*/
+{
+	if(!(-90.0 <= latitude_degrees && latitude_degrees <= 90.0))
+	{
+		return "latitude must be in [-90, +90]";
+	}
+	if(!(-360.0 <= longitude_degrees && longitude_degrees <= 360.0))
+	{
+		return "longitude must be in [-360, +360]";
+	}
+	if(!std::isfinite(height_meters))
+	{
+		return "height must be a finite number of meters";
+	}
+	return nullptr;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+std::size_t StationCatalog::size() const
+{
+	return _size;
+}
+
+
+const double* StationCatalog::latitudes() const
+{
+	return _latitudes;
+}
+
+
+const double* StationCatalog::longitudes() const
+{
+	return _longitudes;
+}
+
+
+const double* StationCatalog::heights() const
+{
+	return _heights;
+}
+
+
+std::string StationCatalog::name(std::size_t index) const
+{
+	if(index >= _name_offsets.size())
+	{
+		return std::string();
+	}
+	return std::string(static_cast<const char*>(_map) + _name_offsets[index], _name_lengths[index]);
+}
+
+
+std::vector<Geolocation> StationCatalog::geolocations() const
+{
+	std::vector<Geolocation> geolocations;
+	geolocations.reserve(_size);
+	for(std::size_t index = 0; index < _size; index++)
+	{
+		geolocations.push_back(Geolocation(_latitudes[index], _longitudes[index], _heights[index]));
+	}
+	return geolocations;
+}
+
+
+void StationCatalog::map_binary(const std::string& path)
+/*
+The arrays are used in place, but every station is checked as a CSV line is.
+*/
+{
+	const Header* header = static_cast<const Header*>(_map);
+	std::string error;
+	if(_map_bytes < sizeof(Header))
+	{
+		error = "is shorter than its header";
+	}
+	else if(header->byte_order != BYTE_ORDER_MARK)
+	{
+		error = "was written with a different byte order";
+	}
+	else if(header->version != VERSION || header->header_bytes != sizeof(Header))
+	{
+		error = "has an unsupported version";
+	}
+	else
+	{
+		for(unsigned int index = 0; index < 3; index++)
+		{
+			std::uint64_t offset = header->component_offset[index];
+			if(offset % sizeof(double) != 0 || offset > _map_bytes
+			  || (_map_bytes - offset) / sizeof(double) < header->count)
+			{
+				error = "is truncated";
+			}
+		}
+	}
+	if(!error.empty())
+	{
+		throw std::runtime_error("Station catalog " + path + " " + error);
+	}
+
+	const char* map = static_cast<const char*>(_map);
+	const double* latitudes = reinterpret_cast<const double*>(map + header->component_offset[0]);
+	const double* longitudes = reinterpret_cast<const double*>(map + header->component_offset[1]);
+	const double* heights = reinterpret_cast<const double*>(map + header->component_offset[2]);
+	for(std::size_t index = 0; index < header->count; index++)
+	{
+		const char* station_error = invalid(latitudes[index], longitudes[index], heights[index]);
+		if(station_error)
+		{
+			throw std::runtime_error("Station catalog " + path + " station " + std::to_string(index + 1) + ": "
+				+ station_error);
+		}
+	}
+
+	_size = header->count;
+	_latitudes = latitudes;
+	_longitudes = longitudes;
+	_heights = heights;
+}
+
+
+void StationCatalog::parse_csv(const std::string& path)
+/*
+One pass to count the lines (so each array is allocated once), one to parse them.
+*/
+{
+	const char* text = static_cast<const char*>(_map);
+	const char* end = text + _map_bytes;
+	std::size_t lines = _map_bytes == 0 ? 0 : std::count(text, end, '\n') + 1;
+	for(std::vector<double>& parsed : _parsed)
+	{
+		parsed.reserve(lines);
+	}
+	_name_offsets.reserve(lines);
+	_name_lengths.reserve(lines);
+
+	bool any_names = false;
+	bool data_seen = false;
+	std::size_t line_number = 1;
+	for(const char* line = text; line < end; line_number++)
+	{
+		const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+		line_end = line_end ? line_end : end;
+		const char* next_line = line_end == end ? end : line_end + 1;
+		while(line_end > line && (line_end[-1] == '\r' || line_end[-1] == ' ' || line_end[-1] == '\t'))
+		{
+			line_end--;
+		}
+
+		const char* position = line;
+		while(position < line_end && (*position == ' ' || *position == '\t'))
+		{
+			position++;
+		}
+		if(position == line_end || *position == '#')
+		{
+			line = next_line;
+			continue;
+		}
+
+		double fields[3] = {0.0, 0.0, 0.0};
+		const char* name = nullptr;
+		const char* error = nullptr;
+		unsigned int field = 0;
+		for(; field < 4 && position < line_end; field++)
+		{
+			if(field != 0)
+			{
+				if(*position != ',')
+				{
+					error = "unexpected text";
+					break;
+				}
+				for(position++; position < line_end && (*position == ' ' || *position == '\t'); position++)
+				{}
+			}
+
+			if(field == 3)
+			{
+				name = position;
+				position = line_end;
+			}
+			else if(field != 2 || (position < line_end && *position != ','))  // An empty height is on the ellipsoid
+			{
+				const char* after = number(position, line_end, fields[field]);
+				if(!after)
+				{
+					error = field == 0 ? "expected a latitude" : field == 1 ? "expected a longitude" : "expected a height";
+					break;
+				}
+				position = after;
+			}
+			while(position < line_end && (*position == ' ' || *position == '\t'))
+			{
+				position++;
+			}
+		}
+
+		if(error && field == 0 && !data_seen)
+		{
+			line = next_line;  // A header line
+			continue;
+		}
+		data_seen = true;
+		if(!error && field < 2)
+		{
+			error = "expected a longitude";
+		}
+		if(!error)
+		{
+			error = invalid(fields[0], fields[1], fields[2]);
+		}
+		if(error)
+		{
+			throw std::runtime_error("Station catalog " + path + " line " + std::to_string(line_number) + ": " + error);
+		}
+
+		for(unsigned int field = 0; field < 3; field++)
+		{
+			_parsed[field].push_back(fields[field]);
+		}
+		_name_offsets.push_back(name ? name - text : 0);
+		_name_lengths.push_back(name ? line_end - name : 0);
+		any_names |= name && name != line_end;
+		line = next_line;
+	}
+
+	if(!any_names)
+	{
+		_name_offsets.clear();
+		_name_lengths.clear();
+	}
+	_size = _parsed[0].size();
+	_latitudes = _parsed[0].data();
+	_longitudes = _parsed[1].data();
+	_heights = _parsed[2].data();
+}
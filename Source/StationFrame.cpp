@@ -0,0 +1,82 @@
+
+
+#include "StationFrame.hpp"
+
+
+#include <cmath>
+
+
+#include "Geolocation.hpp"
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+StationFrame::StationFrame(Geolocation& station)
+/*
+solid.f [LN 57–61]
+```
+|      eht0=0.d0
+|      call geoxyz(gla0,glo0,eht0,x0,y0,z0)
+|      xsta(1)=x0
+|      xsta(2)=y0
+|      xsta(3)=z0
+```
+*/
+: StationFrame((Coordinate<double>)station)
+{}
+
+
+StationFrame::StationFrame(const Coordinate<double>& geo_coordinate)
+/*
+solid.f [LN 474–480] (shared by `st1idiu`, `st1isem`, `st1l1` & `step2lon`)
+```
+|      rsta=dsqrt(xsta(1)**2+xsta(2)**2+xsta(3)**2)
+|      sinphi=xsta(3)/rsta
+|      cosphi=dsqrt(xsta(1)**2+xsta(2)**2)/rsta
+|
+|      cosla=xsta(1)/cosphi/rsta
+|      sinla=xsta(2)/cosphi/rsta
+|      zla = datan2(xsta(2),xsta(1))
+```
+
+solid.f [LN 649–650] (`st1isem`)
+```
+|      costwola=cosla**2-sinla**2
+|      sintwola=2.d0*cosla*sinla
+```
+
+solid.f [LN 189–193] (`detide`)
+```
+|*** computation of new h2 and l2
+|
+|      cosphi=dsqrt(xsta(1)*xsta(1) + xsta(2)*xsta(2))/rsta
+|      h2=h20-0.0006d0*(1.d0-3.d0/2.d0*cosphi*cosphi)
+|      l2=l20+0.0002d0*(1.d0-3.d0/2.d0*cosphi*cosphi)
+```
+
+solid.f [LN 433–435] (the `xcorsta` expression of every correction)
+```
+|      xcorsta(1)=dr*cosla*cosphi-de*sinla-dn*sinphi*cosla
+|      xcorsta(2)=dr*sinla*cosphi+de*cosla-dn*sinphi*sinla
+|      xcorsta(3)=dr*sinphi               +dn*cosphi
+```
+*/
+: geo_coordinate{geo_coordinate},
+  distance{geo_coordinate.distance()},
+  sin_ϕ{geo_coordinate[Z] / distance},
+  cos_ϕ{sqrt(geo_coordinate[X] * geo_coordinate[X] + geo_coordinate[Y] * geo_coordinate[Y]) / distance},
+  sin_squared_ϕ{sin_ϕ * sin_ϕ},
+  cos_squared_ϕ{cos_ϕ * cos_ϕ},
+  sin_2ϕ{2.0 * sin_ϕ * cos_ϕ},
+  cos_2ϕ{cos_squared_ϕ - sin_squared_ϕ},
+  λ{atan2(geo_coordinate[Y], geo_coordinate[X])},
+  sin_λ{geo_coordinate[Y] / cos_ϕ / distance},
+  cos_λ{geo_coordinate[X] / cos_ϕ / distance},
+  sin_2λ{2.0 * cos_λ * sin_λ},
+  cos_2λ{cos_λ * cos_λ - sin_λ * sin_λ},
+  second_degree_love{Geolocation::SECOND_DEGREE_LOVE - 0.0006 * (1.0 - 3.0 / 2.0 * cos_squared_ϕ)},
+  second_degree_shida{Geolocation::SECOND_DEGREE_SHIDA + 0.0002 * (1.0 - 3.0 / 2.0 * cos_squared_ϕ)},
+  up{cos_λ * cos_ϕ, sin_λ * cos_ϕ, sin_ϕ},
+  east{-sin_λ, cos_λ, 0.0},
+  north{-sin_ϕ * cos_λ, -sin_ϕ * sin_λ, cos_ϕ}
+{}
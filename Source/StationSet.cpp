@@ -0,0 +1,80 @@
+
+
+#include "StationSet.hpp"
+
+
+#include "Coordinate.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+#include "StationFrame.hpp"
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+StationSet::StationSet()
+{}
+
+
+StationSet::StationSet(std::vector<Geolocation>& stations)
+{
+	_stations.reserve(stations.size());
+	_station_frames.reserve(stations.size());
+	for(std::size_t index = 0; index < stations.size(); index++)
+	{
+		add(stations[index]);
+	}
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void StationSet::add(Geolocation station)
+{
+	_stations.push_back(station);
+	_station_frames.push_back(StationFrame(station));
+}
+
+
+std::size_t StationSet::size()
+{
+	return _stations.size();
+}
+
+
+void StationSet::tide(unsigned int initial_modified_julian_date, JulianDate& julian_date, double* x, double* y,
+	double* z, Geolocation::LunarSeries lunar_series/*=DIRECT*/
+)
+/*
+solid.f [LN 79–81]
+```
+|        call sunxyz (mjd,fmjd,rsun,lflag)                   !*** mjd/fmjd in UTC
+|        call moonxyz(mjd,fmjd,rmoon,lflag)                  !*** mjd/fmjd in UTC
+|        call detide (xsta,mjd,fmjd,rsun,rmoon,etide,lflag)  !*** mjd/fmjd in UTC
+```
+The epoch's `EpochContext`, `sunxyz` & `moonxyz` are evaluated once; `detide` is called for every station. The
+ displacement (ECEF, meters) of station `index` is written to `x[index]`, `y[index]` & `z[index]`. `lunar_series`
+ opts in to `LunarSeries::ANGLE_ADDITION` for `moonxyz` (see `Geolocation::tide(epoch_context, lunar_series)`).
+*/
+{
+	EpochContext epoch_context(initial_modified_julian_date, julian_date);
+	Coordinate<double> solar_coordinate = Geolocation::sun_coordinates(epoch_context);
+	Coordinate<double> lunar_coordinate = Geolocation::moon_coordinates(epoch_context, lunar_series);
+
+	for(std::size_t index = 0; index < _stations.size(); index++)
+	{
+		Coordinate<double> displacement = _stations[index].tide(epoch_context, _station_frames[index],
+			solar_coordinate, lunar_coordinate);
+		x[index] = displacement[X];
+		y[index] = displacement[Y];
+		z[index] = displacement[Z];
+	}
+}
+
+
+// ———————————————————————————————————————————————————— OPERATOR ———————————————————————————————————————————————————— //
+
+Geolocation& StationSet::operator[](std::size_t index)
+{
+	return _stations[index];
+}
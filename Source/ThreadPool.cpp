@@ -0,0 +1,184 @@
+
+
+#include "ThreadPool.hpp"
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+ThreadPool::ThreadPool(unsigned int threads)
+: _task{nullptr}, _remaining{0}, _generation{0}, _stopping{false}
+{
+	if(threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+		threads = threads == 0 ? 1 : threads;
+	}
+
+	for(unsigned int participant = 0; participant < threads; participant++)
+	{
+		_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+	}
+
+	_threads.reserve(threads - 1);
+	for(unsigned int participant = 1; participant < threads; participant++)
+	{
+		_threads.push_back(std::thread(&ThreadPool::work, this, participant));
+	}
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for(std::size_t index = 0; index < _threads.size(); index++)
+	{
+		_threads[index].join();
+	}
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+unsigned int ThreadPool::size()
+{
+	return _queues.size();
+}
+
+
+void ThreadPool::run(std::size_t tasks, const std::function<void(std::size_t)>& task)
+/*
+Runs `task(index)` for every index in [0, `tasks`) & returns once all have finished. The calling thread takes part.
+*/
+{
+	if(tasks == 0)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> run_lock(_run_mutex);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		_remaining = tasks;
+		_error = nullptr;
+	}
+
+	std::size_t participants = _queues.size();
+	for(std::size_t participant = 0; participant < participants; participant++)
+	{
+		std::lock_guard<std::mutex> lock(_queues[participant]->mutex);
+		for(std::size_t index = participant * tasks / participants; index < (participant + 1) * tasks / participants;
+		  index++)
+		{
+			_queues[participant]->tasks.push_back(index);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_generation++;
+	}
+	_wake.notify_all();
+
+	std::size_t index;
+	const std::function<void(std::size_t)>* function;
+	while(next(0, index, function))
+	{
+		execute(index, *function);
+	}
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this]{ return _remaining == 0; });
+	_task = nullptr;
+	if(_error)
+	{
+		std::exception_ptr error = _error;
+		_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+
+void ThreadPool::work(unsigned int participant)
+{
+	unsigned long long generation = 0;
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this, generation]{ return _stopping || _generation != generation; });
+			if(_stopping)
+			{
+				return;
+			}
+			generation = _generation;
+		}
+
+		std::size_t index;
+		const std::function<void(std::size_t)>* function;
+		while(next(participant, index, function))
+		{
+			execute(index, *function);
+		}
+	}
+}
+
+
+bool ThreadPool::next(unsigned int participant, std::size_t& task, const std::function<void(std::size_t)>*& function)
+/*
+The front of `participant`'s own range, else the back of the first other range that has work left.
+*/
+{
+	std::size_t participants = _queues.size();
+	for(std::size_t offset = 0; offset < participants; offset++)
+	{
+		Queue& queue = *_queues[(participant + offset) % participants];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.tasks.empty())
+		{
+			if(offset == 0)
+			{
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+			}
+			else
+			{
+				task = queue.tasks.back();
+				queue.tasks.pop_back();
+			}
+
+			// Set before the tasks were queued; the queue's mutex orders the two
+			function = _task;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void ThreadPool::execute(std::size_t task, const std::function<void(std::size_t)>& function)
+{
+	try
+	{
+		function(task);
+	}
+	catch(...)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if(!_error)
+		{
+			_error = std::current_exception();
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if(--_remaining == 0)
+	{
+		_done.notify_all();
+	}
+}
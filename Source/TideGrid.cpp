@@ -0,0 +1,168 @@
+
+
+#include "TideGrid.hpp"
+
+
+#include <cmath>
+#include <stdexcept>
+
+
+#include "Coordinate.hpp"
+#include "EpochContext.hpp"
+#include "Geolocation.hpp"
+#include "JulianDate.hpp"
+#include "StationFrame.hpp"
+#include "ThreadPool.hpp"
+
+
+const std::size_t TideGrid::TILE_ROWS = 16;
+const std::size_t TideGrid::TILE_COLUMNS = 256;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+TideGrid::TideGrid(double south_degrees, double north_degrees, double west_degrees, double east_degrees,
+	double resolution_degrees
+)
+: _south{south_degrees}, _west{west_degrees},
+  _resolution{validate(south_degrees, north_degrees, west_degrees, east_degrees, resolution_degrees)},
+  // The tolerance keeps an end that is a whole number of steps away despite rounding (e.g. 180 / 0.1)
+  _rows{static_cast<std::size_t>(std::floor((north_degrees - south_degrees) / resolution_degrees + 1e-9)) + 1},
+  _columns{static_cast<std::size_t>(std::floor((east_degrees - west_degrees) / resolution_degrees + 1e-9)) + 1}
+{}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+double TideGrid::validate(double south_degrees, double north_degrees, double west_degrees, double east_degrees,
+	double resolution_degrees
+)
+/*
+Returns `resolution_degrees` if the box & resolution describe a grid, else throws; it initializes `_resolution`, so
+ that the bounds are validated before `_rows` & `_columns` are counted from them. Longitudes are in solid.f's
+ [-360, +360] (e.g. west -180 & east 180 for a global grid) & span at most 360°.
+*/
+{
+	if(!(resolution_degrees > 0.0) || !std::isfinite(resolution_degrees))
+	{
+		throw std::runtime_error("Grid resolution must be a positive number of degrees");
+	}
+	if(!(south_degrees <= north_degrees) || south_degrees < -90.0 || north_degrees > 90.0)
+	{
+		throw std::runtime_error("Grid latitudes must satisfy -90 <= south <= north <= 90");
+	}
+	if(!(west_degrees <= east_degrees) || west_degrees < -360.0 || east_degrees > 360.0
+	  || east_degrees - west_degrees > 360.0
+	)
+	{
+		throw std::runtime_error("Grid longitudes must satisfy -360 <= west <= east <= 360 & east - west <= 360");
+	}
+	// Keeps the row & column counts (and their product) representable
+	if((north_degrees - south_degrees) / resolution_degrees > 1e9
+	  || (east_degrees - west_degrees) / resolution_degrees > 1e9
+	)
+	{
+		throw std::runtime_error("Grid resolution is too fine for the box (more than 1e9 rows or columns)");
+	}
+	return resolution_degrees;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+std::size_t TideGrid::rows()
+{
+	return _rows;
+}
+
+
+std::size_t TideGrid::columns()
+{
+	return _columns;
+}
+
+
+std::size_t TideGrid::size()
+{
+	return _rows * _columns;
+}
+
+
+double TideGrid::latitude(std::size_t row)
+{
+	return _south + row * _resolution;
+}
+
+
+double TideGrid::longitude(std::size_t column)
+{
+	return _west + column * _resolution;
+}
+
+
+void TideGrid::tide(std::vector<JulianDate>& epochs, double* x, double* y, double* z, ThreadPool& thread_pool,
+	Geolocation::LunarSeries lunar_series/*=DIRECT*/
+)
+/*
+Evaluates the displacement (ECEF, meters) of every grid point at every epoch. `x`, `y` & `z` must each hold
+ `epochs.size()` × `size()` values; the value of point (`row`, `column`) at epoch `epoch` is at
+ [(`epoch` × `rows()` + `row`) × `columns()` + `column`]. `lunar_series` opts in to `LunarSeries::ANGLE_ADDITION`
+ for `moonxyz` (see `Geolocation::tide(epoch_context, lunar_series)`).
+*/
+{
+	std::vector<EpochContext> epoch_contexts;
+	std::vector<Coordinate<double>> solar_coordinates, lunar_coordinates;
+	epoch_contexts.reserve(epochs.size());
+	solar_coordinates.reserve(epochs.size());
+	lunar_coordinates.reserve(epochs.size());
+	for(std::size_t epoch = 0; epoch < epochs.size(); epoch++)
+	{
+		epoch_contexts.push_back(EpochContext(epochs[epoch].modified_julian_date(), epochs[epoch]));
+		solar_coordinates.push_back(Geolocation::sun_coordinates(epoch_contexts[epoch]));
+		lunar_coordinates.push_back(Geolocation::moon_coordinates(epoch_contexts[epoch], lunar_series));
+	}
+
+	std::size_t tile_rows = (_rows + TILE_ROWS - 1) / TILE_ROWS;
+	std::size_t tile_columns = (_columns + TILE_COLUMNS - 1) / TILE_COLUMNS;
+	thread_pool.run(tile_rows * tile_columns,
+		[&](std::size_t tile)
+		{
+			std::size_t first_row = tile / tile_columns * TILE_ROWS;
+			std::size_t first_column = tile % tile_columns * TILE_COLUMNS;
+			std::size_t last_row = first_row + TILE_ROWS < _rows ? first_row + TILE_ROWS : _rows;
+			std::size_t last_column = first_column + TILE_COLUMNS < _columns ? first_column + TILE_COLUMNS : _columns;
+
+			std::vector<Geolocation> stations;
+			std::vector<StationFrame> station_frames;
+			stations.reserve((last_row - first_row) * (last_column - first_column));
+			station_frames.reserve(stations.capacity());
+			for(std::size_t row = first_row; row < last_row; row++)
+			{
+				for(std::size_t column = first_column; column < last_column; column++)
+				{
+					stations.push_back(Geolocation(latitude(row), longitude(column)));
+					station_frames.push_back(StationFrame(stations.back()));
+				}
+			}
+
+			for(std::size_t epoch = 0; epoch < epochs.size(); epoch++)
+			{
+				Coordinate<double> solar_coordinate = solar_coordinates[epoch];
+				Coordinate<double> lunar_coordinate = lunar_coordinates[epoch];
+				std::size_t station = 0;
+				for(std::size_t row = first_row; row < last_row; row++)
+				{
+					std::size_t index = (epoch * _rows + row) * _columns + first_column;
+					for(std::size_t column = first_column; column < last_column; column++, index++, station++)
+					{
+						Coordinate<double> displacement = stations[station].tide(epoch_contexts[epoch],
+							station_frames[station], solar_coordinate, lunar_coordinate);
+						x[index] = displacement[X];
+						y[index] = displacement[Y];
+						z[index] = displacement[Z];
+					}
+				}
+			}
+		}
+	);
+}
@@ -0,0 +1,136 @@
+
+
+#include "TideSeriesFile.hpp"
+
+
+#include <cstring>
+#include <stdexcept>
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#include "TideSeriesWriter.hpp"
+
+
+const char TideSeriesFile::MAGIC[8] = {'S', 'E', 'T', 'I', 'D', 'E', '\0', '\1'};
+const std::uint32_t TideSeriesFile::VERSION = 2;
+const std::uint32_t TideSeriesFile::BYTE_ORDER_MARK = 0x01020304;
+const std::size_t TideSeriesFile::ALIGNMENT;
+
+static_assert(sizeof(TideSeriesFile::Header) == 128, "TideSeriesFile::Header must be 128 bytes");
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+TideSeriesFile::TideSeriesFile(const std::string& path)
+: _map{MAP_FAILED}, _map_bytes{0}, _header{nullptr}
+{
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if(descriptor < 0)
+	{
+		throw std::runtime_error("Unable to open tide series " + path);
+	}
+
+	struct stat status;
+	if(fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header))
+	{
+		close(descriptor);
+		throw std::runtime_error("Tide series " + path + " is shorter than its header");
+	}
+
+	_map_bytes = status.st_size;
+	_map = mmap(nullptr, _map_bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+	if(_map == MAP_FAILED)
+	{
+		throw std::runtime_error("Unable to map tide series " + path);
+	}
+
+	_header = static_cast<const Header*>(_map);
+	std::string error;
+	if(std::memcmp(_header->magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		error = "is not a tide series";
+	}
+	else if(_header->byte_order != BYTE_ORDER_MARK)
+	{
+		error = "was written with a different byte order";
+	}
+	else if(_header->version != VERSION || _header->header_bytes != sizeof(Header))
+	{
+		error = "has an unsupported version";
+	}
+	else if(_header->units != static_cast<std::uint32_t>(Units::METERS))
+	{
+		error = "is not in meters";
+	}
+	else
+	{
+		for(unsigned int index = 0; index < 3; index++)
+		{
+			std::uint64_t offset = _header->component_offset[index];
+			if(offset % sizeof(double) != 0 || offset > _map_bytes
+			  || (_map_bytes - offset) / sizeof(double) < _header->count)
+			{
+				error = "is truncated";
+			}
+		}
+	}
+
+	if(!error.empty())
+	{
+		munmap(_map, _map_bytes);
+		throw std::runtime_error("Tide series " + path + " " + error);
+	}
+}
+
+
+TideSeriesFile::~TideSeriesFile()
+{
+	munmap(_map, _map_bytes);
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+void TideSeriesFile::write(const std::string& path, double latitude_degrees, double longitude_degrees,
+	double height_meters, unsigned int modified_julian_date, double fractional_modified_julian_date,
+	double step_seconds, std::size_t count, Frame frame, const double* component0, const double* component1,
+	const double* component2
+)
+/*
+Writes `count` samples of each component after a header describing them, through a `TideSeriesWriter`.
+*/
+{
+	TideSeriesWriter tide_series_writer(path, latitude_degrees, longitude_degrees, height_meters, modified_julian_date,
+		fractional_modified_julian_date, step_seconds, count, frame);
+	tide_series_writer.write(0, count, component0, component1, component2);
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+const TideSeriesFile::Header& TideSeriesFile::header()
+{
+	return *_header;
+}
+
+
+std::size_t TideSeriesFile::count()
+{
+	return _header->count;
+}
+
+
+const double* TideSeriesFile::component(unsigned int index)
+{
+	if(index > 2)
+	{
+		throw std::runtime_error("Tide series component must be 0, 1 or 2");
+	}
+	return reinterpret_cast<const double*>(static_cast<const char*>(_map) + _header->component_offset[index]);
+}
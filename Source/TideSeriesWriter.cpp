@@ -0,0 +1,115 @@
+
+
+#include "TideSeriesWriter.hpp"
+
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+TideSeriesWriter::TideSeriesWriter(const std::string& path, double latitude_degrees, double longitude_degrees,
+	double height_meters, unsigned int modified_julian_date, double fractional_modified_julian_date,
+	double step_seconds, std::size_t count, TideSeriesFile::Frame frame
+)
+: _path{path}, _file_descriptor{open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)}, _count{count}
+{
+	if(_file_descriptor < 0)
+	{
+		throw std::runtime_error("Unable to create tide series " + path);
+	}
+
+	TideSeriesFile::Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, TideSeriesFile::MAGIC, sizeof(TideSeriesFile::MAGIC));
+	header.version = TideSeriesFile::VERSION;
+	header.byte_order = TideSeriesFile::BYTE_ORDER_MARK;
+	header.header_bytes = sizeof(TideSeriesFile::Header);
+	header.frame = static_cast<std::uint32_t>(frame);
+	header.latitude_degrees = latitude_degrees;
+	header.longitude_degrees = longitude_degrees;
+	header.height_meters = height_meters;
+	header.modified_julian_date = modified_julian_date;
+	header.units = static_cast<std::uint32_t>(TideSeriesFile::Units::METERS);
+	header.fractional_modified_julian_date = fractional_modified_julian_date;
+	header.step_seconds = step_seconds;
+	header.count = count;
+
+	// Each array is padded to the next `ALIGNMENT` boundary
+	std::uint64_t array_bytes = count * sizeof(double);
+	std::uint64_t padded_bytes = (array_bytes + TideSeriesFile::ALIGNMENT - 1) / TideSeriesFile::ALIGNMENT
+		* TideSeriesFile::ALIGNMENT;
+	for(unsigned int index = 0; index < 3; index++)
+	{
+		header.component_offset[index] = sizeof(TideSeriesFile::Header) + index * padded_bytes;
+		_component_offset[index] = header.component_offset[index];
+	}
+
+	try
+	{
+		if(ftruncate(_file_descriptor, sizeof(TideSeriesFile::Header) + 3 * padded_bytes) != 0)
+		{
+			throw std::runtime_error("Unable to size tide series " + path + ": " + std::strerror(errno));
+		}
+		write(&header, sizeof(header), 0);
+	}
+	catch(...)
+	{
+		close(_file_descriptor);
+		throw;
+	}
+}
+
+
+TideSeriesWriter::~TideSeriesWriter()
+{
+	close(_file_descriptor);
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void TideSeriesWriter::write(std::size_t first, std::size_t count, const double* component0,
+	const double* component1, const double* component2
+)
+/*
+Samples [`first`, `first` + `count`) of each component.
+*/
+{
+	if(first > _count || count > _count - first)
+	{
+		throw std::runtime_error("Samples past the end of tide series " + _path);
+	}
+
+	const double* components[3] = {component0, component1, component2};
+	for(unsigned int index = 0; index < 3; index++)
+	{
+		write(components[index], count * sizeof(double), _component_offset[index] + first * sizeof(double));
+	}
+}
+
+
+void TideSeriesWriter::write(const void* data, std::size_t bytes, std::uint64_t offset)
+{
+	std::size_t written = 0;
+	while(written < bytes)
+	{
+		ssize_t result = pwrite(_file_descriptor, static_cast<const char*>(data) + written, bytes - written,
+			offset + written);
+		if(result < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			throw std::runtime_error("Unable to write tide series " + _path + ": " + std::strerror(errno));
+		}
+		written += result;
+	}
+}
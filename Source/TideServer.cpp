@@ -0,0 +1,548 @@
+
+
+#include "TideServer.hpp"
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+#include "JulianDate.hpp"
+#include "StageTimer.hpp"
+#include "TideSeriesFile.hpp"
+
+
+const std::size_t TideServer::EPOCH_CACHE = 4096;
+const std::size_t TideServer::STATION_CACHE = 65536;
+const std::size_t TideServer::OUTPUT_LIMIT = 1 << 20;
+const std::size_t TideServer::LATENCY_SAMPLES = 65536;
+const std::size_t TideServer::PARALLEL_BATCH = 64;
+const unsigned int TideServer::REPORT_SECONDS = 10;
+
+volatile std::sig_atomic_t TideServer::_stop_requested = 0;
+volatile std::sig_atomic_t TideServer::_stop_descriptor = -1;
+
+static_assert(sizeof(TideServer::Query) == 48, "TideServer::Query must be 48 bytes");
+static_assert(sizeof(TideServer::Response) == 40, "TideServer::Response must be 40 bytes");
+
+// Years 1901–2099, as solid.f accepts: 1901-01-01 is MJD 15385 & 2100-01-01 is MJD 88069
+static const std::uint32_t FIRST_MODIFIED_JULIAN_DATE = 15385;
+static const std::uint32_t END_MODIFIED_JULIAN_DATE = 88069;
+
+
+static EpochContext epoch_context(std::uint32_t modified_julian_date, double fractional_modified_julian_date)
+{
+	SOLID_EARTH_TIDE_STAGE(stage_timer, TIME_SCALES);
+	JulianDate julian_date(modified_julian_date, fractional_modified_julian_date);
+	return EpochContext(modified_julian_date, julian_date);
+}
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+TideServer::TideServer(const std::string& socket_path, unsigned int threads/*=0*/,
+	unsigned int coalesce_microseconds/*=0*/
+)
+/*
+Listens on `socket_path`, replacing whatever is there (e.g. the socket of a server that did not stop cleanly).
+*/
+: _socket_path{socket_path}, _coalesce_microseconds{coalesce_microseconds}, _listener{-1}, _stop_pipe{-1, -1},
+  _thread_pool(threads), _queries{0}, _batches{0}, _reported_queries{0}, _last_report{Clock::now()}
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path))
+	{
+		throw std::runtime_error("Socket path must be 1 to " + std::to_string(sizeof(address.sun_path) - 1)
+			+ " characters: " + socket_path);
+	}
+	std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+	_listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(_listener < 0)
+	{
+		throw std::runtime_error(std::string("Unable to create socket: ") + std::strerror(errno));
+	}
+	unlink(socket_path.c_str());
+	if(bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+	  || listen(_listener, SOMAXCONN) != 0
+	)
+	{
+		std::string error = std::strerror(errno);
+		close(_listener);
+		throw std::runtime_error("Unable to listen on " + socket_path + ": " + error);
+	}
+	if(pipe2(_stop_pipe, O_NONBLOCK | O_CLOEXEC) != 0)
+	{
+		std::string error = std::strerror(errno);
+		close(_listener);
+		unlink(socket_path.c_str());
+		throw std::runtime_error("Unable to create stop pipe: " + error);
+	}
+	_stop_descriptor = _stop_pipe[1];
+}
+
+
+TideServer::~TideServer()
+{
+	for(Client& client : _clients)
+	{
+		close_client(client);
+	}
+	_stop_descriptor = -1;
+	close(_stop_pipe[0]);
+	close(_stop_pipe[1]);
+	close(_listener);
+	unlink(_socket_path.c_str());
+}
+
+
+TideServer::Station::Station(const Query& query)
+: geolocation(query.latitude_degrees, query.longitude_degrees, query.height_meters), station_frame(geolocation)
+{}
+
+
+TideServer::Epoch::Epoch(const EpochKey& key)
+/*
+solid.f [LN 79–80]
+```
+|        call sunxyz (mjd,fmjd,rsun,lflag)                   !*** mjd/fmjd in UTC
+|        call moonxyz(mjd,fmjd,rmoon,lflag)                  !*** mjd/fmjd in UTC
+```
+*/
+: epoch_context(::epoch_context(key.first, key.second)),
+  solar_coordinate(Geolocation::sun_coordinates(epoch_context)),
+  lunar_coordinate(Geolocation::moon_coordinates(epoch_context, Geolocation::LunarSeries::DIRECT))
+{}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+void TideServer::stop(int/*=0*/)
+/*
+Sets the flag `run()` checks, & writes a byte to the server's stop pipe so that a `ppoll` already waiting (or about to)
+ returns at once. Only async-signal-safe calls, keeping `errno` as the interrupted code had it.
+*/
+{
+	_stop_requested = 1;
+	int descriptor = _stop_descriptor;
+	if(descriptor >= 0)
+	{
+		int saved_errno = errno;
+		char byte = 0;
+		if(write(descriptor, &byte, 1) < 0)
+		{
+			// Full: a byte is already waiting to wake `ppoll`
+		}
+		errno = saved_errno;
+	}
+}
+
+
+std::size_t TideServer::readable_bytes(const Client& client)
+/*
+How many bytes of queries the client may send before its responses (unsent & pending) reach `OUTPUT_LIMIT`.
+*/
+{
+	std::size_t responses = client.output.size() + client.pending * sizeof(Response);
+	return responses < OUTPUT_LIMIT ? (OUTPUT_LIMIT - responses) / sizeof(Response) * sizeof(Query) : 0;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+void TideServer::run()
+/*
+One thread polls the socket, every client & the stop pipe. A batch is evaluated as soon as the queries that arrived
+ are read, or once the oldest has waited `_coalesce_microseconds` for more.
+*/
+{
+	std::vector<pollfd> descriptors;
+	while(!_stop_requested)
+	{
+		descriptors.assign(1, pollfd{_listener, POLLIN, 0});
+		for(const Client& client : _clients)
+		{
+			descriptors.push_back(pollfd{client.descriptor, static_cast<short>(client.descriptor < 0 ? 0
+				: (readable_bytes(client) ? POLLIN : 0) | (client.output.empty() ? 0 : POLLOUT)), 0});
+		}
+		// Readable once `stop()` has been called, even if that was after the check above
+		descriptors.push_back(pollfd{_stop_pipe[0], POLLIN, 0});
+
+		Clock::duration wait = std::chrono::seconds(REPORT_SECONDS);
+		if(!_pending.empty())
+		{
+			wait = _pending.front().received + std::chrono::microseconds(_coalesce_microseconds) - Clock::now();
+			wait = std::max(wait, Clock::duration::zero());
+		}
+		timespec timeout;
+		timeout.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(wait).count();
+		timeout.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count() % 1000000000;
+		if(ppoll(descriptors.data(), descriptors.size(), &timeout, nullptr) < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			throw std::runtime_error(std::string("Unable to poll clients: ") + std::strerror(errno));
+		}
+
+		Clock::time_point now = Clock::now();
+		for(std::size_t client = 0; client < _clients.size(); client++)
+		{
+			short events = descriptors[client + 1].revents;
+			if(events & POLLOUT)
+			{
+				send_output(_clients[client]);
+			}
+			if(events & (POLLIN | POLLHUP | POLLERR))
+			{
+				read_client(client, now);
+			}
+		}
+		if(descriptors[0].revents & POLLIN)
+		{
+			accept_clients();
+		}
+
+		if(!_pending.empty()
+		  && now - _pending.front().received >= std::chrono::microseconds(_coalesce_microseconds)
+		)
+		{
+			evaluate();
+		}
+		if(_pending.empty())
+		{
+			_clients.erase(std::remove_if(_clients.begin(), _clients.end(),
+				[](const Client& client){ return client.descriptor < 0; }), _clients.end());
+		}
+		report(now);
+	}
+
+	std::cerr << "tide server: " << latency_report() << "\n";
+}
+
+
+std::string TideServer::latency_report()
+/*
+Queries & batches so far, & the latency percentiles (nearest rank) of the last `LATENCY_SAMPLES` queries.
+*/
+{
+	char text[256];
+	if(_latencies.empty())
+	{
+		std::snprintf(text, sizeof(text), "%zu queries in %zu batches", _queries, _batches);
+		return text;
+	}
+
+	std::vector<double> latencies = _latencies;
+	std::size_t median = (latencies.size() + 1) / 2 - 1;
+	std::nth_element(latencies.begin(), latencies.begin() + median, latencies.end());
+	double p50 = latencies[median];
+	std::size_t tail = static_cast<std::size_t>(std::ceil(latencies.size() * 0.99)) - 1;
+	std::nth_element(latencies.begin(), latencies.begin() + tail, latencies.end());
+	double p99 = latencies[tail];
+
+	std::snprintf(text, sizeof(text), "%zu queries in %zu batches (%.1f per batch), latency p50 %.1f µs, p99 %.1f µs",
+		_queries, _batches, static_cast<double>(_queries) / _batches, p50, p99);
+	return text;
+}
+
+
+void TideServer::accept_clients()
+{
+	while(true)
+	{
+		int descriptor = accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(descriptor < 0)
+		{
+			return;  // EAGAIN: none left; anything else concerns that client only
+		}
+		_clients.push_back(Client{descriptor, std::vector<char>(), std::vector<char>(), 0});
+	}
+}
+
+
+void TideServer::read_client(std::size_t client, Clock::time_point now)
+/*
+Reads what the client has sent, up to `readable_bytes()`, & queues each complete query.
+*/
+{
+	Client& reader = _clients[client];
+	char buffer[64 * sizeof(Query)];
+	while(reader.descriptor >= 0)
+	{
+		std::size_t readable = readable_bytes(reader);
+		readable = readable > reader.input.size() ? readable - reader.input.size() : 0;
+		if(!readable)
+		{
+			break;
+		}
+		ssize_t received = recv(reader.descriptor, buffer, std::min(sizeof(buffer), readable), 0);
+		if(received > 0)
+		{
+			reader.input.insert(reader.input.end(), buffer, buffer + received);
+		}
+		else if(received < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else
+		{
+			if(received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+			{
+				close_client(reader);
+			}
+			break;
+		}
+	}
+
+	std::size_t queries = reader.input.size() / sizeof(Query);
+	for(std::size_t index = 0; index < queries; index++)
+	{
+		Pending pending = Pending();
+		pending.client = client;
+		std::memcpy(&pending.query, reader.input.data() + index * sizeof(Query), sizeof(Query));
+		pending.received = now;
+		_pending.push_back(pending);
+	}
+	reader.pending += queries;
+	reader.input.erase(reader.input.begin(), reader.input.begin() + queries * sizeof(Query));
+}
+
+
+void TideServer::evaluate()
+/*
+Answers the pending batch: finds (or builds) the station & epoch of every query, evaluating each missing epoch once
+ however many queries share it, then runs `detide` per query. The slots of the missing epochs are found before the
+ pool fills them, so that its tasks touch only their own slot & never the map. Stations & epochs beyond the caches are
+ evicted (oldest first) only once the batch is answered, since its queries point at them.
+*/
+{
+	std::vector<EpochKey> missing;
+	std::vector<std::unique_ptr<Epoch>*> missing_slots;
+	for(Pending& pending : _pending)
+	{
+		const Query& query = pending.query;
+		pending.response.id = query.id;
+		if(!(-90.0 <= query.latitude_degrees && query.latitude_degrees <= 90.0)
+		  || !(-360.0 <= query.longitude_degrees && query.longitude_degrees <= 360.0)
+		  || !std::isfinite(query.height_meters) || query.modified_julian_date < FIRST_MODIFIED_JULIAN_DATE
+		  || query.modified_julian_date >= END_MODIFIED_JULIAN_DATE
+		  || !(0.0 <= query.fractional_modified_julian_date && query.fractional_modified_julian_date < 1.0)
+		  || query.frame > static_cast<std::uint32_t>(TideSeriesFile::Frame::ENU)
+		)
+		{
+			pending.response.status = static_cast<std::uint32_t>(Status::INVALID);
+			continue;
+		}
+
+		Coordinates coordinates(query.latitude_degrees, query.longitude_degrees, query.height_meters);
+		std::unique_ptr<Station>& station = _stations[coordinates];
+		if(!station)
+		{
+			station.reset(new Station(query));
+			_station_order.push_back(coordinates);
+		}
+		pending.station = station.get();
+
+		EpochKey key(query.modified_julian_date, query.fractional_modified_julian_date);
+		std::pair<std::map<EpochKey, std::unique_ptr<Epoch>>::iterator, bool> epoch = _epochs.insert(
+			std::make_pair(key, std::unique_ptr<Epoch>()));
+		if(epoch.second)
+		{
+			missing.push_back(key);
+			missing_slots.push_back(&epoch.first->second);
+			_epoch_order.push_back(key);
+		}
+	}
+
+	_thread_pool.run(missing.size() >= 2 ? missing.size() : 0,
+		[&](std::size_t index){ missing_slots[index]->reset(new Epoch(missing[index])); });
+	if(missing.size() == 1)
+	{
+		missing_slots[0]->reset(new Epoch(missing[0]));
+	}
+	for(Pending& pending : _pending)
+	{
+		if(pending.station)
+		{
+			pending.epoch = _epochs[EpochKey(pending.query.modified_julian_date,
+				pending.query.fractional_modified_julian_date)].get();
+		}
+	}
+
+	if(_pending.size() >= PARALLEL_BATCH && _thread_pool.size() > 1)
+	{
+		const std::size_t chunk = 16;
+		_thread_pool.run((_pending.size() + chunk - 1) / chunk,
+			[&](std::size_t task)
+			{
+				for(std::size_t index = task * chunk; index < std::min((task + 1) * chunk, _pending.size()); index++)
+				{
+					answer(_pending[index]);
+				}
+			}
+		);
+	}
+	else
+	{
+		for(Pending& pending : _pending)
+		{
+			answer(pending);
+		}
+	}
+
+	for(const Pending& pending : _pending)
+	{
+		Client& client = _clients[pending.client];
+		client.pending--;
+		if(client.descriptor >= 0)
+		{
+			const char* bytes = reinterpret_cast<const char*>(&pending.response);
+			client.output.insert(client.output.end(), bytes, bytes + sizeof(Response));
+		}
+	}
+	for(Client& client : _clients)
+	{
+		if(!client.output.empty())
+		{
+			send_output(client);
+		}
+	}
+
+	Clock::time_point answered = Clock::now();
+	for(const Pending& pending : _pending)
+	{
+		double latency = std::chrono::duration<double, std::micro>(answered - pending.received).count();
+		if(_latencies.size() < LATENCY_SAMPLES)
+		{
+			_latencies.push_back(latency);
+		}
+		else
+		{
+			_latencies[_queries % LATENCY_SAMPLES] = latency;
+		}
+		_queries++;
+	}
+	_batches++;
+	_pending.clear();
+
+	while(_epoch_order.size() > EPOCH_CACHE)
+	{
+		_epochs.erase(_epoch_order.front());
+		_epoch_order.pop_front();
+	}
+	while(_station_order.size() > STATION_CACHE)
+	{
+		_stations.erase(_station_order.front());
+		_station_order.pop_front();
+	}
+}
+
+
+void TideServer::answer(Pending& pending)
+/*
+solid.f [LN 81...89]
+```
+|        call detide (xsta,mjd,fmjd,rsun,rmoon,etide,lflag)  !*** mjd/fmjd in UTC
+⋮
+|        call rge(gla0,glo0,ut,vt,wt,xt,   yt,   zt)       !*** tide vector
+```
+*/
+{
+	if(!pending.station)
+	{
+		return;
+	}
+
+	Station& station = *pending.station;
+	const Epoch& epoch = *pending.epoch;
+	Coordinate<double> solar_coordinate = epoch.solar_coordinate;
+	Coordinate<double> lunar_coordinate = epoch.lunar_coordinate;
+	Coordinate<double> displacement = station.geolocation.tide(epoch.epoch_context, station.station_frame,
+		solar_coordinate, lunar_coordinate);
+
+	double x = displacement[X], y = displacement[Y], z = displacement[Z];
+	Response& response = pending.response;
+	response.status = static_cast<std::uint32_t>(Status::OK);
+	response.leap_second_flag = epoch.epoch_context.leap_second_flag;
+	if(pending.query.frame == static_cast<std::uint32_t>(TideSeriesFile::Frame::ENU))
+	{
+		double north, east, up;
+		station.geolocation.local_horizon(1, &x, &y, &z, &north, &east, &up);
+		x = east;
+		y = north;
+		z = up;
+	}
+	response.displacement[0] = x;
+	response.displacement[1] = y;
+	response.displacement[2] = z;
+}
+
+
+void TideServer::send_output(Client& client)
+{
+	std::size_t sent = 0;
+	while(client.descriptor >= 0 && sent < client.output.size())
+	{
+		ssize_t result = send(client.descriptor, client.output.data() + sent, client.output.size() - sent,
+			MSG_NOSIGNAL);
+		if(result > 0)
+		{
+			sent += result;
+		}
+		else if(result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else
+		{
+			if(result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+			{
+				close_client(client);
+			}
+			break;
+		}
+	}
+	client.output.erase(client.output.begin(), client.output.begin() + std::min(sent, client.output.size()));
+}
+
+
+void TideServer::close_client(Client& client)
+{
+	if(client.descriptor >= 0)
+	{
+		close(client.descriptor);
+		client.descriptor = -1;
+		client.output.clear();
+		client.input.clear();
+	}
+}
+
+
+void TideServer::report(Clock::time_point now)
+{
+	if(now - _last_report >= std::chrono::seconds(REPORT_SECONDS))
+	{
+		if(_queries != _reported_queries)
+		{
+			std::cerr << "tide server: " << latency_report() << "\n";
+			_reported_queries = _queries;
+		}
+		_last_report = now;
+	}
+}
@@ -0,0 +1,161 @@
+
+
+#include "UniformEpochs.hpp"
+
+
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+
+#include "EpochContext.hpp"
+#include "JulianDate.hpp"
+
+
+const std::size_t UniformEpochs::MAX_ANCHOR_INTERVAL;
+const double UniformEpochs::ANGLE_TOLERANCE = 1e-10;
+
+// The largest angle a context evaluates before reducing it: the Greenwich hour angle a century from J2000 (radians)
+static const double LARGEST_ANGLE = (280.46061837 + 360.98564736629 * 36525.0) / 57.29577951308232;
+
+
+// —————————————————————————————————————————————————— CONSTRUCTORS —————————————————————————————————————————————————— //
+
+UniformEpochs::UniformEpochs(unsigned int modified_julian_date, double fractional_modified_julian_date,
+	double step_seconds
+)
+: _modified_julian_date{modified_julian_date}, _start_seconds{fractional_modified_julian_date * 86400.0},
+  _step_seconds{step_seconds}, _anchor_interval{step_seconds > 0.0 ? anchor_interval(step_seconds) : 1}
+{
+	if(!(step_seconds > 0.0))
+	{
+		throw std::runtime_error("Series step must be a positive number of seconds");
+	}
+}
+
+
+// ————————————————————————————————————————————————————— STATIC ————————————————————————————————————————————————————— //
+
+std::size_t UniformEpochs::anchor_interval(double step_seconds)
+/*
+The samples between anchors for a series `step_seconds` apart. Each advanced sample adds to every angle
+- the rounding of one rotation by the step: a few units in the last place, 2 `DBL_EPSILON` radians, &
+- the error of the step itself, which is measured over `EpochContext::PROBE_DAYS` between two directly evaluated angles
+   that are each rounded by up to `DBL_EPSILON` × `LARGEST_ANGLE`, scaled by the step's share of that span,
+so the longest interval whose sum stays within `ANGLE_TOLERANCE` is kept (at least 1 sample).
+*/
+{
+	double step_error = 2.0 * DBL_EPSILON
+		+ 2.0 * DBL_EPSILON * LARGEST_ANGLE * step_seconds / (EpochContext::PROBE_DAYS * 86400.0);
+	std::size_t interval = MAX_ANCHOR_INTERVAL;
+	while(interval > 1 && interval * step_error > ANGLE_TOLERANCE)
+	{
+		interval >>= 1;
+	}
+	return interval;
+}
+
+
+// ————————————————————————————————————————————————————— OTHER  ————————————————————————————————————————————————————— //
+
+JulianDate UniformEpochs::julian_date(std::size_t index) const
+/*
+The UTC epoch of sample `index`. Derived from the index (not accumulated) so that multi-year series do not drift. Whole
+ days are carried into the MJD, so that the leap second lookup sees the day the sample is actually in.
+*/
+{
+	double seconds = _start_seconds + index * _step_seconds;
+	double days = std::floor(seconds / 86400.0);
+	return JulianDate(_modified_julian_date + static_cast<int>(days), (seconds - days * 86400.0) / 86400.0);
+}
+
+
+std::size_t UniformEpochs::anchor_interval() const
+{
+	return _anchor_interval;
+}
+
+
+std::size_t UniformEpochs::anchor(std::size_t index) const
+/*
+The sample that `index` is advanced from: the latest multiple of the anchor interval, or the first sample of the UTC day
+ of `index` when that is later.
+*/
+{
+	std::size_t interval_anchor = index - index % _anchor_interval;
+	double index_day = day(index);
+	if(day(interval_anchor) == index_day)
+	{
+		return interval_anchor;
+	}
+
+	// First sample at or after the start of the day; the estimate is corrected against `day()` itself
+	double estimate = std::ceil((index_day * 86400.0 - _start_seconds) / _step_seconds);
+	std::size_t first = estimate <= interval_anchor ? interval_anchor + 1 : static_cast<std::size_t>(estimate);
+	if(first > index)
+	{
+		first = index;
+	}
+	while(first > interval_anchor + 1 && day(first - 1) == index_day)
+	{
+		first--;
+	}
+	while(day(first) != index_day)
+	{
+		first++;
+	}
+	return first;
+}
+
+
+void UniformEpochs::epochs(std::size_t first, std::size_t count, std::vector<EpochContext>& epoch_contexts) const
+/*
+Appends the contexts of samples [`first`, `first` + `count`) to `epoch_contexts`. A `first` that is not an anchor is
+ reached by advancing from its anchor, which costs up to an anchor interval of extra samples.
+*/
+{
+	EpochContext::Step step;
+	for(std::size_t index = first; index < first + count; index++)
+	{
+		std::size_t index_anchor = anchor(index);
+		if(index_anchor == index)
+		{
+			epoch_contexts.push_back(anchor_context(index, step));
+		}
+		else if(index != first)
+		{
+			JulianDate sample = julian_date(index);
+			epoch_contexts.push_back(EpochContext(sample, epoch_contexts.back(), step));
+		}
+		else
+		{
+			std::vector<EpochContext> walk;
+			walk.reserve(index - index_anchor + 1);
+			walk.push_back(anchor_context(index_anchor, step));
+			for(std::size_t sample_index = index_anchor + 1; sample_index <= index; sample_index++)
+			{
+				JulianDate sample = julian_date(sample_index);
+				walk.push_back(EpochContext(sample, walk.back(), step));
+			}
+			epoch_contexts.push_back(walk.back());
+		}
+	}
+}
+
+
+double UniformEpochs::day(std::size_t index) const
+{
+	return std::floor((_start_seconds + index * _step_seconds) / 86400.0);
+}
+
+
+EpochContext UniformEpochs::anchor_context(std::size_t index, EpochContext::Step& step) const
+/*
+The context of anchor `index`, evaluated directly, & the step that advances the samples after it.
+*/
+{
+	JulianDate anchor_date = julian_date(index);
+	EpochContext anchor_epoch(anchor_date.modified_julian_date(), anchor_date);
+	step = EpochContext::step(anchor_epoch, _step_seconds);
+	return anchor_epoch;
+}